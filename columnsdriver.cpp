@@ -0,0 +1,157 @@
+/////////////////////////////  columnsdriver.cpp  ////////////////////////////
+// Exercises EmployeeColumns: checks sum, min, max, countRange, filterRange
+// and histogram on both int columns against a walk of the List<Employee>
+// they were built from, and that operator<< and exportTo give exactly the
+// list's text (equal names included). Also times sum against the walk.
+//
+//    g++ -std=c++11 -O3 -pthread columnsdriver.cpp employeecolumns.cpp
+//        employee.cpp nodedata.cpp
+//    ./a.out [rounds] [employees]
+//
+// Exits with 1 if any answer differs.
+//----------------------------------------------------------------------------
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+using namespace std;
+
+#include "list.h"
+#include "employee.h"
+#include "employeecolumns.h"
+#include "driverutil.h"
+
+const int NAMES = 30;                       // few, so names repeat
+
+//--------------------------------  valueOf  ---------------------------------
+int valueOf(const Employee& employee, EmployeeColumns::Column which) {
+   return which == EmployeeColumns::ID ? employee.getIdNumber()
+                                       : employee.getSalary();
+}
+
+//------------------------------  walkValues  --------------------------------
+// one column, by walking the list
+vector<int> walkValues(const List<Employee>& list,
+                       EmployeeColumns::Column which) {
+   vector<int> values;
+   for (List<Employee>::const_iterator it = list.begin(); it != list.end();
+        ++it)
+      values.push_back(valueOf(*it, which));
+   return values;
+}
+
+//-----------------------------  checkColumn  --------------------------------
+// every kernel on one column against the walked values, with a few random
+// ranges and bucket layouts; returns the number of answers that differ
+int checkColumn(const EmployeeColumns& store, const List<Employee>& list,
+                EmployeeColumns::Column which, int spread) {
+   vector<int> values = walkValues(list, which);
+   int n = values.size();
+   int failures = 0;
+
+   long long sum = 0;
+   int lowest = 0, highest = 0;
+   for (int i = 0; i < n; i++) {
+      sum += values[i];
+      if (i == 0 || values[i] < lowest)
+         lowest = values[i];
+      if (i == 0 || values[i] > highest)
+         highest = values[i];
+   }
+   failures += store.sum(which) != sum;
+   failures += store.min(which) != lowest;
+   failures += store.max(which) != highest;
+
+   for (int q = 0; q < 5; q++) {
+      int lo = rand() % spread - spread / 10;
+      int hi = lo + rand() % spread;
+      if (q == 0)
+         hi = lo - 1;                       // empty range
+      vector<int> rows, expected;
+      for (int i = 0; i < n; i++) {
+         if (lo <= values[i] && values[i] <= hi)
+            expected.push_back(i);
+      }
+      failures += store.countRange(which, lo, hi) != (int)expected.size();
+      failures += store.filterRange(which, lo, hi, rows) !=
+                  (int)expected.size();
+      failures += rows != expected;
+   }
+
+   for (int q = 0; q < 5; q++) {
+      int lo = rand() % spread - spread / 10;
+      int width = q == 0 ? 0 : rand() % (spread / 4 + 1) + 1;
+      vector<int> counts(rand() % 12), expected(counts.size(), 0);
+      if (width > 0) {
+         for (int i = 0; i < n; i++) {
+            for (size_t b = 0; b < expected.size(); b++) {
+               if (lo + (long long)b * width <= values[i] &&
+                   values[i] < lo + (long long)(b + 1) * width)
+                  expected[b]++;
+            }
+         }
+      }
+      store.histogram(which, lo, width, counts);
+      failures += counts != expected;
+   }
+   return failures;
+}
+
+//-------------------------------  checkText  --------------------------------
+// the store prints like the list and exports to a list that prints the same
+int checkText(const EmployeeColumns& store, const List<Employee>& list) {
+   List<Employee> exported;
+   store.exportTo(exported);
+   int failures = (text(store) != text(list)) + (text(exported) != text(list));
+   failures += exported.size() != list.size() || store.size() != list.size();
+   return failures;
+}
+
+int main(int argc, char* argv[]) {
+   int rounds = argc > 1 ? atoi(argv[1]) : 500;
+   int employees = argc > 2 ? atoi(argv[2]) : 1000000;
+   srand(19);
+
+   int failures = 0;
+   for (int round = 0; round < rounds; round++) {
+      List<Employee> company;
+      vector<Employee*> items;
+      int size = round == 0 ? 0 : rand() % 60;
+      for (int i = 0; i < size; i++)
+         items.push_back(randomEmployee(rand() % 10000, NAMES));
+      stable_sort(items.begin(), items.end(), lessByName);
+      company.appendRun(items);
+
+      EmployeeColumns store(company);
+      int before = failures;
+      failures += checkColumn(store, company, EmployeeColumns::ID, 10000);
+      failures += checkColumn(store, company, EmployeeColumns::SALARY,
+                              100000);
+      failures += checkText(store, company);
+      if (failures != before)
+         cout << "round " << round << " (" << size << " employees) differs"
+              << endl;
+   }
+   cout << rounds << " random rounds, " << failures << " failures" << endl;
+
+   // timing: one big list, the salary total from the column and by a walk
+   List<Employee> company;
+   randomList(company, employees, NAMES);
+   EmployeeColumns store(company);
+   TimePoint start = now();
+   long long walked = 0;
+   for (List<Employee>::const_iterator it = company.begin();
+        it != company.end(); ++it)
+      walked += it->getSalary();
+   double walkTime = seconds(start);
+   start = now();
+   long long summed = store.sum(EmployeeColumns::SALARY);
+   double sumTime = seconds(start);
+   failures += walked != summed;
+   cout << company.size() << " employees, salary sum  walk " << walkTime
+        << "s  column " << sumTime << "s" << endl;
+
+   cout << (failures == 0 ? "all answers agree" : "answers differ") << endl;
+   return failures == 0 ? 0 : 1;
+}
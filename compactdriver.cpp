@@ -0,0 +1,147 @@
+////////////////////////////  compactdriver.cpp  /////////////////////////////
+// Exercises CompactList: runs the same random inserts, removes, merges,
+// intersects and compactions on three List<Employee>s and three
+// CompactList<Employee>s, the params and result of merge and intersect
+// picked freely among the three so every aliasing is tried, and checks
+// after each step that every CompactList prints exactly like its List
+// (equal names included). Merging two equal lists into one of them is the
+// case the header documents: the List ends up empty, the CompactList keeps
+// one copy. Also times printing a large list of each kind.
+//
+//    g++ -std=c++11 -O2 -pthread compactdriver.cpp employee.cpp nodedata.cpp
+//    ./a.out [rounds] [employees]
+//
+// Exits with 1 if a CompactList differs.
+//----------------------------------------------------------------------------
+
+#include <iostream>
+#include <string>
+#include <cstdlib>
+using namespace std;
+
+#include "list.h"
+#include "compactlist.h"
+#include "employee.h"
+#include "driverutil.h"
+
+const int NAMES = 5;                        // few, so names repeat
+const int KINDS = 3;                        // lists of each kind
+
+enum Operation { INSERT, REMOVE, MERGE, INTERSECT, COMPACT, COPY };
+const char* const names[] = { "insert", "remove", "merge", "intersect",
+                              "compact", "copy" };
+
+//--------------------------------  sameAll  ---------------------------------
+bool sameAll(List<Employee> lists[], CompactList<Employee> compacts[]) {
+   for (int i = 0; i < KINDS; i++) {
+      if (text(compacts[i]) != text(lists[i]) ||
+          compacts[i].size() != lists[i].size() ||
+          compacts[i].isEmpty() != lists[i].isEmpty())
+         return false;
+   }
+   return true;
+}
+
+//---------------------------------  step  -----------------------------------
+// one random operation on both kinds; false if its own result differs
+bool step(Operation op, List<Employee> lists[],
+          CompactList<Employee> compacts[], int id) {
+   int r = rand() % KINDS, a = rand() % KINDS, b = rand() % KINDS;
+   switch (op) {
+      case INSERT: {
+         Employee* e = randomEmployee(id, NAMES);
+         compacts[a].insert(new Employee(*e));
+         lists[a].insert(e);
+         return true;
+      }
+      case REMOVE: {
+         Employee* key = randomEmployee(0, NAMES);
+         Employee* fromList;
+         Employee* fromCompact;
+         bool inList = lists[a].remove(*key, fromList);
+         bool inCompact = compacts[a].remove(*key, fromCompact);
+         bool same = inList == inCompact &&
+                     (!inList || text(*fromList) == text(*fromCompact));
+         delete key;
+         delete fromList;
+         delete fromCompact;
+         return same;
+      }
+      case MERGE: {
+         // equal lists into one of them: List::merge leaves it empty,
+         // CompactList::merge keeps the one copy
+         if (a != b && (r == a || r == b) && lists[a] == lists[b]) {
+            string kept = text(lists[a]);
+            lists[r].merge(lists[a], lists[b]);
+            compacts[r].merge(compacts[a], compacts[b]);
+            bool same = lists[r].isEmpty() && text(compacts[r]) == kept &&
+                        compacts[a + b - r].isEmpty();
+            // leave both kinds alike for the steps after
+            lists[r].makeEmpty();
+            compacts[r].exportTo(lists[r]);
+            return same;
+         }
+         lists[r].merge(lists[a], lists[b]);
+         compacts[r].merge(compacts[a], compacts[b]);
+         return true;
+      }
+      case INTERSECT:
+         lists[r].intersect(lists[a], lists[b]);
+         compacts[r].intersect(compacts[a], compacts[b]);
+         return true;
+      case COMPACT:
+         compacts[a].compact();
+         return true;
+      case COPY:
+         // equal contents in two lists, so merge meets them now and then
+         if (a != b) {
+            lists[b] = lists[a];
+            compacts[b] = compacts[a];
+         }
+         return true;
+   }
+   return true;
+}
+
+int main(int argc, char* argv[]) {
+   int rounds = argc > 1 ? atoi(argv[1]) : 1000;
+   int employees = argc > 2 ? atoi(argv[2]) : 200000;
+   srand(29);
+
+   int failures = 0;
+   int id = 0;
+   for (int round = 0; round < rounds; round++) {
+      List<Employee> lists[KINDS];
+      CompactList<Employee> compacts[KINDS];
+      for (int i = 0; i < KINDS; i++) {
+         randomList(lists[i], rand() % 12, NAMES);
+         compacts[i] = CompactList<Employee>(lists[i]);
+      }
+      for (int s = 0; s < 12; s++) {
+         Operation op = (Operation)(rand() % 6);
+         if (!step(op, lists, compacts, id++) || !sameAll(lists, compacts)) {
+            cout << names[op] << " differs in round " << round << endl;
+            failures++;
+            break;
+         }
+      }
+   }
+   cout << rounds << " random rounds, " << failures << " failed" << endl;
+
+   // timing: printing the same employees from a List and a CompactList
+   List<Employee> company;
+   randomList(company, employees, employees / 4 + 1);
+   CompactList<Employee> compact(company);
+   TimePoint start = now();
+   string listText = text(company);
+   double listTime = seconds(start);
+   start = now();
+   string compactText = text(compact);
+   double compactTime = seconds(start);
+   failures += listText != compactText;
+   cout << company.size() << " employees printed  List " << listTime
+        << "s  CompactList " << compactTime << "s" << endl;
+
+   cout << failures << " failures" << endl;
+   return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,436 @@
+////////////////////////////  compactlist.h  /////////////////////////////////
+// Sorted linked list whose nodes live in one array and link by index
+
+#ifndef COMPACTLIST_H
+#define COMPACTLIST_H
+
+#include <iostream>
+#include <fstream>
+#include <utility>
+#include <vector>
+#include <stdint.h>
+#include "list.h"
+using namespace std;
+
+//--------------------------  class CompactList  -----------------------------
+// Same ADT as List<T> (sorted by listCompare of T) with a denser layout: the
+// nodes are slots of one growable array, each holding the item itself and
+// the 32 bit index of the next slot. There is no per node allocation and
+// no per node pointer, so a node costs sizeof(T) + 4 bytes instead of two
+// pointers plus one or two malloc headers.
+//
+// After many inserts and removes the chain jumps around the array;
+// compact() rewrites the slots in sorted order so walks (operator<<, merge,
+// intersect) read the array front to back. merge and intersect build their
+// result in that order already.
+//
+// Assumptions:
+//   -- T has a default constructor and copy (or move) assignment.
+//   -- Pointers from retrieve are valid until the next insert, merge,
+//      intersect or compact, any of which may move the slots. They point
+//      to const items, the slots hold the items themselves and a changed
+//      item could break the order.
+//   -- Like List::merge, merging two distinct lists with equal contents
+//      keeps one copy. List::merge ends up empty when the result is one of
+//      those lists; here it keeps the copy.
+//   -- remove hands back a heap copy of the item, the caller deletes it.
+//   -- At most 2^31 - 1 items, the count is an int like List's.
+//----------------------------------------------------------------------------
+
+template <typename T>
+class CompactList {
+
+   // output operator, walks the chain in order
+   friend ostream& operator<<(ostream& output, const CompactList<T>& thelist) {
+      for (uint32_t i = thelist.head; i != NIL; i = thelist.slots[i].next)
+         output << thelist.slots[i].data;
+      return output;
+   }
+
+public:
+   CompactList();                           // default constructor
+   CompactList(const List<T>&);             // same items as a List
+
+   bool operator==(const CompactList&) const;
+   bool operator!=(const CompactList&) const;
+   bool insert(T*);                         // insert, takes the item
+   bool remove(const T&, T*&);              // removes the first equal item
+   bool retrieve(const T&, const T*&) const;  // finds the first equal item
+   bool isEmpty() const;
+   int size() const;
+   void buildList(ifstream&);               // build a list from datafile
+   void merge(CompactList&, CompactList&);  // params end up empty
+   void intersect(CompactList&, CompactList&);  // params unchanged
+   void makeEmpty();
+   void compact();                          // slots into traversal order
+   void exportTo(List<T>&) const;           // insert copies into a List
+
+private:
+   static const uint32_t NIL = 0xffffffffu;  // end of a chain
+
+   struct Slot {
+      T data;                               // the item itself
+      uint32_t next;                        // index of next slot or NIL
+   };
+
+   vector<Slot> slots;                      // every node, used or free
+   uint32_t head;                           // first slot of the list
+   uint32_t freeSlots;                      // chain of unused slots
+   int count;                               // number of items
+
+   uint32_t newSlot();                      // free slot or a new one
+};
+
+template <typename T>
+const uint32_t CompactList<T>::NIL;
+
+//----------------------------------------------------------------------------
+// Constructor
+template <typename T>
+CompactList<T>::CompactList()
+{
+    head = NIL;
+    freeSlots = NIL;
+    count = 0;
+}
+
+//----------------------------------------------------------------------------
+// Constructor
+// the List is already sorted, so its items fill the slots in order
+template <typename T>
+CompactList<T>::CompactList(const List<T>& list)
+{
+    freeSlots = NIL;
+    count = list.size();
+    slots.reserve(count);
+    for (typename List<T>::const_iterator it = list.begin(); it != list.end();
+         ++it)
+    {
+        Slot slot;
+        slot.data = *it;
+        slot.next = slots.size() + 1;
+        slots.push_back(slot);
+    }
+    if (count > 0)
+        slots.back().next = NIL;
+    head = (count > 0 ? 0 : NIL);
+}
+
+//----------------------------------------------------------------------------
+// operator==
+// same rules as List: empty lists are never equal
+template <typename T>
+bool CompactList<T>::operator==(const CompactList& list) const
+{
+    if (isEmpty() || list.isEmpty() || count != list.count)
+        return false;
+    if (this == &list)
+        return true;
+
+    uint32_t cur = head;
+    uint32_t cur2 = list.head;
+    while (cur != NIL)
+    {
+        if (listCompare(slots[cur].data, list.slots[cur2].data) != 0)
+            return false;
+        cur = slots[cur].next;
+        cur2 = list.slots[cur2].next;
+    }
+    return true;
+}
+
+//----------------------------------------------------------------------------
+// operator!=
+template <typename T>
+bool CompactList<T>::operator!=(const CompactList& list) const
+{
+    return !operator==(list);
+}
+
+//----------------------------------------------------------------------------
+// insert
+// the item is moved into a slot and the caller's object deleted
+template <typename T>
+bool CompactList<T>::insert(T* dataptr)
+{
+    uint32_t slot = newSlot();
+    slots[slot].data = std::move(*dataptr);
+    delete dataptr;
+    count++;
+
+    if (head == NIL || listCompare(slots[slot].data, slots[head].data) < 0)
+    {
+        slots[slot].next = head;
+        head = slot;
+        return true;
+    }
+
+    uint32_t previous = head;
+    uint32_t current = slots[head].next;
+    while (current != NIL &&
+           listCompare(slots[current].data, slots[slot].data) < 0)
+    {
+        previous = current;
+        current = slots[current].next;
+    }
+    slots[slot].next = current;
+    slots[previous].next = slot;
+    return true;
+}
+
+//----------------------------------------------------------------------------
+// remove
+// unlinks the first item equal to target, its slot goes on the free chain
+template <typename T>
+bool CompactList<T>::remove(const T& target, T*& p)
+{
+    uint32_t previous = NIL;
+    for (uint32_t cur = head; cur != NIL; cur = slots[cur].next)
+    {
+        int order = listCompare(slots[cur].data, target);
+        if (order > 0)
+            break;
+        if (order == 0)
+        {
+            if (previous == NIL)
+                head = slots[cur].next;
+            else
+                slots[previous].next = slots[cur].next;
+            p = new T(std::move(slots[cur].data));
+            slots[cur].data = T();
+            slots[cur].next = freeSlots;
+            freeSlots = cur;
+            count--;
+            return true;
+        }
+        previous = cur;
+    }
+    p = NULL;
+    return false;
+}
+
+//----------------------------------------------------------------------------
+// retrieve
+template <typename T>
+bool CompactList<T>::retrieve(const T& target, const T*& p) const
+{
+    for (uint32_t cur = head; cur != NIL; cur = slots[cur].next)
+    {
+        int order = listCompare(slots[cur].data, target);
+        if (order > 0)
+            break;
+        if (order == 0)
+        {
+            p = &slots[cur].data;
+            return true;
+        }
+    }
+    p = NULL;
+    return false;
+}
+
+//----------------------------------------------------------------------------
+// isEmpty
+template <typename T>
+bool CompactList<T>::isEmpty() const
+{
+    return head == NIL;
+}
+
+//----------------------------------------------------------------------------
+// size
+template <typename T>
+int CompactList<T>::size() const
+{
+    return count;
+}
+
+//----------------------------------------------------------------------------
+// buildList
+// continually insert new items into the list
+template <typename T>
+void CompactList<T>::buildList(ifstream& infile)
+{
+    for (;;)
+    {
+        T* ptr = new T;
+        bool successfulRead = ptr->setData(infile);
+        if (infile.eof() || !infile)
+        {
+            delete ptr;
+            break;
+        }
+        if (!successfulRead)
+            delete ptr;
+        else if (!insert(ptr))
+            break;
+    }
+}
+
+//----------------------------------------------------------------------------
+// merge
+// walks both chains once, writing the merged items into a new array in
+// order, so the result is already compact. Equal items keep list1's first.
+template <typename T>
+void CompactList<T>::merge(CompactList& list1, CompactList& list2)
+{
+    if (&list1 == &list2)
+    {
+        //merging a list with itself leaves it as it is
+        if (this != &list1)
+        {
+            *this = list1;
+            list1.makeEmpty();
+        }
+        return;
+    }
+    if (list1 == list2)
+    {
+        //equal lists merge to one copy of them, as List::merge does
+        if (this != &list1)
+        {
+            *this = list1;
+            list1.makeEmpty();
+        }
+        if (this != &list2)
+            list2.makeEmpty();
+        return;
+    }
+
+    vector<Slot> merged;
+    merged.reserve(list1.count + list2.count);
+    uint32_t cur = list1.head;
+    uint32_t cur2 = list2.head;
+    while (cur != NIL || cur2 != NIL)
+    {
+        Slot slot;
+        if (cur2 == NIL ||
+            (cur != NIL && listCompare(list1.slots[cur].data,
+                                       list2.slots[cur2].data) <= 0))
+        {
+            slot.data = std::move(list1.slots[cur].data);
+            cur = list1.slots[cur].next;
+        }
+        else
+        {
+            slot.data = std::move(list2.slots[cur2].data);
+            cur2 = list2.slots[cur2].next;
+        }
+        slot.next = merged.size() + 1;
+        merged.push_back(slot);
+    }
+    if (!merged.empty())
+        merged.back().next = NIL;
+
+    int total = merged.size();
+    list1.makeEmpty();
+    list2.makeEmpty();
+    makeEmpty();
+    slots.swap(merged);
+    count = total;
+    head = (total > 0 ? 0 : NIL);
+}
+
+//----------------------------------------------------------------------------
+// intersect
+// items found in both lists, in a new compact array; params unchanged
+template <typename T>
+void CompactList<T>::intersect(CompactList& list1, CompactList& list2)
+{
+    vector<Slot> common;
+    uint32_t cur = list1.head;
+    uint32_t cur2 = list2.head;
+    while (cur != NIL && cur2 != NIL)
+    {
+        const T& item = list1.slots[cur].data;
+        const T& item2 = list2.slots[cur2].data;
+        int order = listCompare(item, item2);
+        if (order == 0)
+        {
+            Slot slot;
+            slot.data = item;
+            slot.next = common.size() + 1;
+            common.push_back(slot);
+            cur = list1.slots[cur].next;
+            cur2 = list2.slots[cur2].next;
+        }
+        else if (order < 0)
+            cur = list1.slots[cur].next;
+        else
+            cur2 = list2.slots[cur2].next;
+    }
+    if (!common.empty())
+        common.back().next = NIL;
+
+    int total = common.size();
+    makeEmpty();
+    slots.swap(common);
+    count = total;
+    head = (total > 0 ? 0 : NIL);
+}
+
+//----------------------------------------------------------------------------
+// makeEmpty
+template <typename T>
+void CompactList<T>::makeEmpty()
+{
+    vector<Slot>().swap(slots);
+    head = NIL;
+    freeSlots = NIL;
+    count = 0;
+}
+
+//----------------------------------------------------------------------------
+// compact
+// rewrites the slots in traversal order and drops the free ones, so the
+// next walk is sequential through the array
+template <typename T>
+void CompactList<T>::compact()
+{
+    vector<Slot> ordered;
+    ordered.reserve(count);
+    for (uint32_t cur = head; cur != NIL; cur = slots[cur].next)
+    {
+        Slot slot;
+        slot.data = std::move(slots[cur].data);
+        slot.next = ordered.size() + 1;
+        ordered.push_back(slot);
+    }
+    if (!ordered.empty())
+        ordered.back().next = NIL;
+
+    slots.swap(ordered);
+    head = (count > 0 ? 0 : NIL);
+    freeSlots = NIL;
+}
+
+//----------------------------------------------------------------------------
+// exportTo
+// copies in chain order, handed to the List as one sorted run
+template <typename T>
+void CompactList<T>::exportTo(List<T>& list) const
+{
+    vector<T*> run;
+    run.reserve(count);
+    for (uint32_t cur = head; cur != NIL; cur = slots[cur].next)
+        run.push_back(new T(slots[cur].data));
+    list.appendRun(run);
+}
+
+//----------------------------------------------------------------------------
+// newSlot
+// reuses a removed slot before growing the array
+template <typename T>
+uint32_t CompactList<T>::newSlot()
+{
+    if (freeSlots != NIL)
+    {
+        uint32_t slot = freeSlots;
+        freeSlots = slots[slot].next;
+        return slot;
+    }
+    slots.push_back(Slot());
+    return slots.size() - 1;
+}
+
+#endif
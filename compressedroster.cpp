@@ -0,0 +1,206 @@
+/////////////////////////  compressedroster.cpp  /////////////////////////////
+
+#include "compressedroster.h"
+#include <cstring>
+
+const int CompressedRoster::BLOCK;
+
+//--------------------------  constructor  -----------------------------------
+CompressedRoster::CompressedRoster() : count(0) { }
+
+//--------------------------  constructor  -----------------------------------
+// snapshot of the given list
+CompressedRoster::CompressedRoster(const List<Employee>& list) : count(0) {
+   build(list);
+}
+
+//------------------------------  build  -------------------------------------
+// replace the contents with the employees of list, one walk of the list.
+// Ids and salaries are zigzag coded so the -1 of an invalid one stays small.
+void CompressedRoster::build(const List<Employee>& list) {
+   records.clear();
+   restarts.clear();
+   count = 0;
+
+   string previous;
+   string key;
+   for (List<Employee>::const_iterator it = list.begin(); it != list.end();
+        ++it) {
+      key = it->getLastName();
+      key += '\0';
+      key += it->getFirstName();
+
+      size_t shared = 0;
+      if (count % BLOCK == 0)
+         restarts.push_back(records.size());
+      else {
+         size_t most = key.size() < previous.size() ? key.size()
+                                                    : previous.size();
+         while (shared < most && key[shared] == previous[shared])
+            shared++;
+      }
+
+      putVarint(records, shared);
+      putVarint(records, key.size() - shared);
+      records.append(key, shared, string::npos);
+      int id = it->getIdNumber();
+      int salary = it->getSalary();
+      putVarint(records, ((uint32_t)id << 1) ^ (uint32_t)(id >> 31));
+      putVarint(records, ((uint32_t)salary << 1) ^ (uint32_t)(salary >> 31));
+
+      previous.swap(key);
+      count++;
+   }
+   records.shrink_to_fit();
+   restarts.shrink_to_fit();
+}
+
+//-----------------------------  exportTo  -----------------------------------
+// insert a copy of every employee into list, decoding front to back
+void CompressedRoster::exportTo(List<Employee>& list) const {
+   vector<Employee*> all;
+   all.reserve(count);
+   string key;
+   int id, salary;
+   const char* at = records.data();
+   for (int row = 0; row < count; row++) {
+      at = decode(at, key, id, salary);
+      all.push_back(new Employee(toEmployee(key, id, salary)));
+   }
+   list.appendRun(all);
+}
+
+//-------------------------------  size  -------------------------------------
+int CompressedRoster::size() const {
+   return count;
+}
+
+//----------------------------  bytesUsed  -----------------------------------
+size_t CompressedRoster::bytesUsed() const {
+   return records.capacity() + restarts.capacity() * sizeof(uint32_t);
+}
+
+//-----------------------------  retrieve  -----------------------------------
+// binary search for the last block whose restart key is < name, then decode
+// from there until the keys pass name. Like List::retrieve, it is the first
+// of equal names that is found, which may be in a later block.
+bool CompressedRoster::retrieve(const EmployeeName& name,
+                                Employee& found) const {
+   int low = 0;
+   int high = restarts.size();              // blocks [low, high) undecided
+   while (low < high) {
+      int mid = (low + high) / 2;
+      const char* at = records.data() + restarts[mid];
+      getVarint(at);                        // shared, 0 at a restart
+      uint32_t length = getVarint(at);
+      if (compareKey(at, length, name) < 0)
+         low = mid + 1;
+      else
+         high = mid;
+   }
+
+   int block = low > 0 ? low - 1 : 0;
+   const char* at = records.data() + (restarts.empty() ? 0 : restarts[block]);
+   string key;
+   int id, salary;
+   for (int row = block * BLOCK; row < count; row++) {
+      at = decode(at, key, id, salary);
+      int order = compareKey(key.data(), key.size(), name);
+      if (order == 0) {
+         found = toEmployee(key, id, salary);
+         return true;
+      }
+      if (order > 0)
+         break;
+   }
+   return false;
+}
+
+//----------------------------  putVarint  -----------------------------------
+// 7 bits per byte, low bits first, high bit set on all but the last byte
+void CompressedRoster::putVarint(string& out, uint32_t value) {
+   while (value >= 0x80) {
+      out += (char)(value | 0x80);
+      value >>= 7;
+   }
+   out += (char)value;
+}
+
+//----------------------------  getVarint  -----------------------------------
+uint32_t CompressedRoster::getVarint(const char*& at) {
+   uint32_t value = 0;
+   int shift = 0;
+   unsigned char byte;
+   do {
+      byte = *at++;
+      value |= (uint32_t)(byte & 0x7f) << shift;
+      shift += 7;
+   } while (byte & 0x80);
+   return value;
+}
+
+//------------------------------  decode  ------------------------------------
+// reads the record at at, key holding the previous record's key on the way
+// in and this one's on the way out; returns where the next record starts
+const char* CompressedRoster::decode(const char* at, string& key, int& id,
+                                     int& salary) {
+   uint32_t shared = getVarint(at);
+   uint32_t unshared = getVarint(at);
+   key.resize(shared);
+   key.append(at, unshared);
+   at += unshared;
+   uint32_t zigzag = getVarint(at);
+   id = (int)(zigzag >> 1) ^ -(int)(zigzag & 1);
+   zigzag = getVarint(at);
+   salary = (int)(zigzag >> 1) ^ -(int)(zigzag & 1);
+   return at;
+}
+
+//----------------------------  compareKey  ----------------------------------
+// an encoded key against a name, in Employee::compare order
+int CompressedRoster::compareKey(const char* key, size_t length,
+                                 const EmployeeName& name) {
+   const char* split = (const char*)memchr(key, '\0', length);
+   size_t lastLength = split - key;
+   size_t firstLength = length - lastLength - 1;
+
+   int order = string::traits_type::compare(key, name.last,
+      lastLength < name.lastLength ? lastLength : name.lastLength);
+   if (order != 0)
+      return order;
+   if (lastLength != name.lastLength)
+      return lastLength < name.lastLength ? -1 : 1;
+
+   order = string::traits_type::compare(split + 1, name.first,
+      firstLength < name.firstLength ? firstLength : name.firstLength);
+   if (order != 0)
+      return order;
+   if (firstLength != name.firstLength)
+      return firstLength < name.firstLength ? -1 : 1;
+   return 0;
+}
+
+//----------------------------  toEmployee  ----------------------------------
+Employee CompressedRoster::toEmployee(const string& key, int id, int salary) {
+   size_t split = key.find('\0');
+   return Employee(key.substr(0, split), key.substr(split + 1), id, salary);
+}
+
+//-------------------------------  <<  ---------------------------------------
+// display every employee the way Employee prints itself, decoding the
+// records in one pass
+ostream& operator<<(ostream& output, const CompressedRoster& roster) {
+   string key;
+   int id, salary;
+   const char* at = roster.records.data();
+   for (int row = 0; row < roster.count; row++) {
+      at = CompressedRoster::decode(at, key, id, salary);
+      size_t split = key.find('\0');
+      output << setw(4) << id << setw(7) << salary << "  ";
+      output.write(key.data(), split);
+      output << " ";
+      output.write(key.data() + split + 1, key.size() - split - 1);
+      output << endl;
+   }
+   return output;
+}
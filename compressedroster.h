@@ -0,0 +1,61 @@
+/////////////////////////  compressedroster.h  ///////////////////////////////
+// Front coded, read only copy of a List<Employee>
+
+#ifndef COMPRESSEDROSTER_H
+#define COMPRESSEDROSTER_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include "list.h"
+#include "employee.h"
+using namespace std;
+
+//-----------------------  class CompressedRoster  ---------------------------
+// Holds the same employees as a List<Employee>, in the same (name) order,
+// in one byte string. Neighbours in that order share long name prefixes,
+// so each record stores only how much of the previous key (last name, a
+// 0 byte, first name) it shares and the bytes after that, then the id and
+// salary as varints. Every BLOCK records a restart record stores its key
+// whole; retrieve binary searches the restart keys and decodes from one
+// block on (one block unless a name repeats across it), operator<< and
+// exportTo decode front to back.
+//
+// Assumptions:
+//   -- The roster is a snapshot, later changes to the list are not seen.
+//   -- Names contain no 0 byte (setData reads them as words).
+//----------------------------------------------------------------------------
+
+class CompressedRoster {
+   friend ostream& operator<<(ostream&, const CompressedRoster&);
+
+public:
+   CompressedRoster();                      // empty roster
+   CompressedRoster(const List<Employee>&); // snapshot of a list
+
+   void build(const List<Employee>&);       // replace contents with a list
+   void exportTo(List<Employee>&) const;    // insert copies into a list
+   int size() const;                        // number of employees
+   size_t bytesUsed() const;                // encoded records and restarts
+
+   // the employee with that name, decoded into found
+   bool retrieve(const EmployeeName&, Employee& found) const;
+
+private:
+   static const int BLOCK = 16;             // records per restart
+
+   string records;                          // every record, encoded
+   vector<uint32_t> restarts;               // offset of each block's first
+                                            // record in records
+   int count;                               // number of employees
+
+   static void putVarint(string&, uint32_t);
+   static uint32_t getVarint(const char*&);
+   static const char* decode(const char*, string& key, int& id,
+                             int& salary);
+   static int compareKey(const char*, size_t, const EmployeeName&);
+   static Employee toEmployee(const string& key, int id, int salary);
+};
+
+#endif
@@ -0,0 +1,67 @@
+//////////////////////////////  driverutil.h  ////////////////////////////////
+// Helpers shared by the driver programs (statdriver.cpp, viewdriver.cpp and
+// the others): random employees, printed text to compare lists and views
+// by, and wall clock timing.
+
+#ifndef DRIVERUTIL_H
+#define DRIVERUTIL_H
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include "list.h"
+#include "employee.h"
+using namespace std;
+
+//-------------------------------  randomEmployee  ---------------------------
+// last name one of names choices ("Last0", "Last1", ...), first name "F",
+// so with few names the lists hold runs of equal names
+inline Employee* randomEmployee(int id, int names) {
+   ostringstream last;
+   last << "Last" << rand() % names;
+   return new Employee(last.str(), "F", id, 20000 + rand() % 80000);
+}
+
+//-------------------------------  lessByName  -------------------------------
+inline bool lessByName(const Employee* a, const Employee* b) {
+   return *a < *b;
+}
+
+//------------------------------  randomList  --------------------------------
+// size random employees, sorted first and appended as one run, so building
+// costs O(n log n) however large the list is
+inline void randomList(List<Employee>& list, int size, int names) {
+   vector<Employee*> items;
+   for (int i = 0; i < size; i++)
+      items.push_back(randomEmployee(i, names));
+   stable_sort(items.begin(), items.end(), lessByName);
+   list.appendRun(items);
+}
+
+//---------------------------------  text  -----------------------------------
+// what operator<< prints, so two containers compare item by item, equal
+// names included
+template <typename Printable>
+string text(const Printable& printable) {
+   ostringstream out;
+   out << printable;
+   return out.str();
+}
+
+//--------------------------------  seconds  ---------------------------------
+// wall clock time since start, waits for the disk or other threads included
+typedef chrono::steady_clock::time_point TimePoint;
+
+inline TimePoint now() {
+   return chrono::steady_clock::now();
+}
+
+inline double seconds(TimePoint start) {
+   return chrono::duration<double>(now() - start).count();
+}
+
+#endif
@@ -1,4 +1,5 @@
 #include "employee.h"
+#include <cstring>
 
 // incomplete class and not fully documented
 
@@ -33,6 +34,12 @@ Employee::~Employee() { }
       return *this;
    }
 
+//---------------------------  accessors  ------------------------------------
+const string& Employee::getLastName() const { return lastName; }
+const string& Employee::getFirstName() const { return firstName; }
+int Employee::getIdNumber() const { return idNumber; }
+int Employee::getSalary() const { return salary; }
+
 //-----------------------------  setData  ------------------------------------
 // set data from file
 bool Employee::setData(ifstream& inFile) {
@@ -40,31 +47,47 @@ bool Employee::setData(ifstream& inFile) {
    return idNumber  >= 0 && idNumber <= MAXID && salary >= 0;
 }
 
+//----------------------------  compare  -------------------------------------
+// three way comparison by name: negative, zero or positive as this is
+// before, equal to or after obj. The first name is only looked at when
+// the last names match, and each name is scanned once.
+int Employee::compare(const Employee& obj) const {
+   int order = lastName.compare(obj.lastName);
+   return order != 0 ? order : firstName.compare(obj.firstName);
+}
+
+//----------------------------  compare  -------------------------------------
+// same order as above against a name key, comparing the characters in
+// place
+int Employee::compare(const EmployeeName& key) const {
+   int order = lastName.compare(0, string::npos, key.last, key.lastLength);
+   return order != 0 ? order
+          : firstName.compare(0, string::npos, key.first, key.firstLength);
+}
+
 //-------------------------------  <  ----------------------------------------
 // < defined by value of name
 bool Employee::operator<(const Employee& obj) const {
-   return lastName < obj.lastName ||
-          (lastName == obj.lastName && firstName < obj.firstName);
+   return compare(obj) < 0;
 }
 
 
 //-------------------------------  <= ----------------------------------------
 // < defined by value of inamedNumber
 bool Employee::operator<=(const Employee& obj) const {
-   return *this < obj || *this == obj;
+   return compare(obj) <= 0;
 }
 
 //-------------------------------  >  ----------------------------------------
 // > defined by value of name
 bool Employee::operator>(const Employee& obj) const {
-   return lastName > obj.lastName ||
-          (lastName == obj.lastName && firstName > obj.firstName);
+   return compare(obj) > 0;
 }
 
 //-------------------------------  >= ----------------------------------------
 // < defined by value of name
 bool Employee::operator>=(const Employee& obj) const {
-   return *this > obj || *this == obj;
+   return compare(obj) >= 0;
 }
 
 //----------------- operator == (equality) ----------------
@@ -81,6 +104,47 @@ bool Employee::operator!=(const Employee& obj) const {
    return !(*this == obj);
 }
 
+//----------------------------  hashValue  -----------------------------------
+// hash of the name, the same fields operator== compares, so equal
+// Employees always hash the same
+unsigned long hashValue(const Employee& obj) {
+   hash<string> hashString;
+   return hashString(obj.lastName) * 31 + hashString(obj.firstName);
+}
+
+//---------------------------  serialize  ------------------------------------
+// binary form for ListJournal: each name as its length then its characters,
+// then idNumber and salary
+void serialize(string& out, const Employee& obj) {
+   int length = obj.lastName.size();
+   out.append(reinterpret_cast<const char*>(&length), sizeof(int));
+   out += obj.lastName;
+   length = obj.firstName.size();
+   out.append(reinterpret_cast<const char*>(&length), sizeof(int));
+   out += obj.firstName;
+   out.append(reinterpret_cast<const char*>(&obj.idNumber), sizeof(int));
+   out.append(reinterpret_cast<const char*>(&obj.salary), sizeof(int));
+}
+
+//--------------------------  deserialize  -----------------------------------
+// reads what serialize wrote, advancing in; false if it runs past end
+bool deserialize(const char*& in, const char* end, Employee& obj) {
+   int length;
+   for (int field = 0; field < 2; field++) {
+      if (end - in < (long)sizeof(int)) return false;
+      memcpy(&length, in, sizeof(int));
+      in += sizeof(int);
+      if (length < 0 || end - in < length) return false;
+      (field == 0 ? obj.lastName : obj.firstName).assign(in, length);
+      in += length;
+   }
+   if (end - in < 2 * (long)sizeof(int)) return false;
+   memcpy(&obj.idNumber, in, sizeof(int));
+   memcpy(&obj.salary, in + sizeof(int), sizeof(int));
+   in += 2 * sizeof(int);
+   return true;
+}
+
 //-------------------------------  <<  ---------------------------------------
 // display Employee object
 
@@ -6,12 +6,19 @@
 #include <iomanip>
 #include <fstream>
 #include <string>
+#include <cstring>
+#include <functional>
 using namespace std;
 
 const int MAXID = 9999;
 
+struct EmployeeName;
+
 class Employee {
    friend ostream& operator<<(ostream &, const Employee &);
+   friend unsigned long hashValue(const Employee &);  // for List fingerprint
+   friend void serialize(string&, const Employee&);   // for ListJournal
+   friend bool deserialize(const char*&, const char*, Employee&);
 
 public:
    Employee(string = "dummyLast", string = "dummyFirst", int = 0, int = 0);
@@ -20,7 +27,15 @@ public:
    bool setData(ifstream&);         // fill object with data from file
    Employee& operator=(const Employee&);
 
-   // comparison operators
+   // accessors, used by the companion containers
+   const string& getLastName() const;
+   const string& getFirstName() const;
+   int getIdNumber() const;
+   int getSalary() const;
+
+   // comparison operators, all in terms of compare
+   int compare(const Employee&) const;   // <0, 0, >0 by last then first name
+   int compare(const EmployeeName&) const;  // same order against a name key
    bool operator<(const Employee&) const;
    bool operator<=(const Employee&) const;
    bool operator>(const Employee&) const;
@@ -35,4 +50,36 @@ private:
    int salary;                           // employee's salary
 };
 
+// lookup key for a List<Employee>: a last and first name that are only
+// pointed to, not copied, so List::retrieve, remove and lowerBound can
+// search by name without building an Employee (two strings) per query.
+// The characters must outlive the key.
+struct EmployeeName {
+   EmployeeName(const char* last, const char* first)
+      : last(last), lastLength(strlen(last)),
+        first(first), firstLength(strlen(first)) { }
+   EmployeeName(const string& last, const string& first)
+      : last(last.data()), lastLength(last.size()),
+        first(first.data()), firstLength(first.size()) { }
+
+   // a temporary string would be gone before the key is used
+   EmployeeName(string&&, string&&) = delete;
+   EmployeeName(string&&, const string&) = delete;
+   EmployeeName(const string&, string&&) = delete;
+
+   const char* last;
+   size_t lastLength;
+   const char* first;
+   size_t firstLength;
+};
+
+// keys for indexing a List<Employee> by something other than the name
+struct EmployeeId {
+   int operator()(const Employee& obj) const { return obj.getIdNumber(); }
+};
+
+struct EmployeeSalary {
+   int operator()(const Employee& obj) const { return obj.getSalary(); }
+};
+
 #endif
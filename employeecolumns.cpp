@@ -0,0 +1,173 @@
+//////////////////////////  employeecolumns.cpp  /////////////////////////////
+
+#include "employeecolumns.h"
+
+//--------------------------  constructor  -----------------------------------
+EmployeeColumns::EmployeeColumns() {
+   nameStart.push_back(0);
+}
+
+//--------------------------  constructor  -----------------------------------
+// snapshot of the given list
+EmployeeColumns::EmployeeColumns(const List<Employee>& list) {
+   build(list);
+}
+
+//------------------------------  build  -------------------------------------
+// replace the contents with the employees of list, one walk of the list
+void EmployeeColumns::build(const List<Employee>& list) {
+   int n = list.size();
+   ids.clear();
+   salaries.clear();
+   names.clear();
+   nameStart.clear();
+   ids.reserve(n);
+   salaries.reserve(n);
+   nameStart.reserve(2 * n + 1);
+
+   for (List<Employee>::const_iterator it = list.begin(); it != list.end();
+        ++it) {
+      ids.push_back(it->getIdNumber());
+      salaries.push_back(it->getSalary());
+      nameStart.push_back(names.size());
+      names += it->getLastName();
+      nameStart.push_back(names.size());
+      names += it->getFirstName();
+   }
+   nameStart.push_back(names.size());
+}
+
+//-----------------------------  exportTo  -----------------------------------
+// insert a copy of every employee into list, in row order
+void EmployeeColumns::exportTo(List<Employee>& list) const {
+   vector<Employee*> rows;
+   rows.reserve(size());
+   for (int row = 0; row < size(); row++) {
+      rows.push_back(new Employee(lastName(row), firstName(row), ids[row],
+                                  salaries[row]));
+   }
+   list.appendRun(rows);
+}
+
+//-------------------------------  size  -------------------------------------
+int EmployeeColumns::size() const {
+   return ids.size();
+}
+
+//---------------------------  row access  -----------------------------------
+int EmployeeColumns::idNumber(int row) const { return ids[row]; }
+int EmployeeColumns::salary(int row) const { return salaries[row]; }
+
+string EmployeeColumns::lastName(int row) const {
+   return names.substr(nameStart[2 * row],
+                       nameStart[2 * row + 1] - nameStart[2 * row]);
+}
+
+string EmployeeColumns::firstName(int row) const {
+   return names.substr(nameStart[2 * row + 1],
+                       nameStart[2 * row + 2] - nameStart[2 * row + 1]);
+}
+
+//------------------------------  column  ------------------------------------
+const vector<int>& EmployeeColumns::column(Column which) const {
+   return which == ID ? ids : salaries;
+}
+
+//-------------------------------  sum  --------------------------------------
+// total of a column, accumulated in 64 bits
+long long EmployeeColumns::sum(Column which) const {
+   const vector<int>& values = column(which);
+   const int* v = values.data();
+   int n = values.size();
+   long long total = 0;
+   for (int i = 0; i < n; i++)
+      total += v[i];
+   return total;
+}
+
+//-------------------------------  min  --------------------------------------
+int EmployeeColumns::min(Column which) const {
+   const vector<int>& values = column(which);
+   const int* v = values.data();
+   int n = values.size();
+   if (n == 0) return 0;
+   int lowest = v[0];
+   for (int i = 1; i < n; i++)
+      lowest = v[i] < lowest ? v[i] : lowest;
+   return lowest;
+}
+
+//-------------------------------  max  --------------------------------------
+int EmployeeColumns::max(Column which) const {
+   const vector<int>& values = column(which);
+   const int* v = values.data();
+   int n = values.size();
+   if (n == 0) return 0;
+   int highest = v[0];
+   for (int i = 1; i < n; i++)
+      highest = v[i] > highest ? v[i] : highest;
+   return highest;
+}
+
+//----------------------------  countRange  ----------------------------------
+// number of rows with lo <= value <= hi
+int EmployeeColumns::countRange(Column which, int lo, int hi) const {
+   const vector<int>& values = column(which);
+   const int* v = values.data();
+   int n = values.size();
+   int found = 0;
+   for (int i = 0; i < n; i++)
+      found += (v[i] >= lo) & (v[i] <= hi);
+   return found;
+}
+
+//----------------------------  filterRange  ---------------------------------
+// rows with lo <= value <= hi, in order. Every row index is written and the
+// output position only moves on a match, so the loop has no branch.
+int EmployeeColumns::filterRange(Column which, int lo, int hi,
+                                 vector<int>& rows) const {
+   const vector<int>& values = column(which);
+   const int* v = values.data();
+   int n = values.size();
+   rows.resize(n + 1);
+   int* out = rows.data();
+   int found = 0;
+   for (int i = 0; i < n; i++) {
+      out[found] = i;
+      found += (v[i] >= lo) & (v[i] <= hi);
+   }
+   rows.resize(found);
+   return found;
+}
+
+//-----------------------------  histogram  ----------------------------------
+// counts[b] becomes the number of rows with lo + b*width <= value <
+// lo + (b+1)*width, for every bucket b the caller sized counts for; values
+// outside all the buckets are not counted
+void EmployeeColumns::histogram(Column which, int lo, int width,
+                                vector<int>& counts) const {
+   const vector<int>& values = column(which);
+   const int* v = values.data();
+   int n = values.size();
+   int buckets = counts.size();
+   for (int b = 0; b < buckets; b++)
+      counts[b] = 0;
+   if (width <= 0) return;
+
+   for (int i = 0; i < n; i++) {
+      long long offset = (long long)v[i] - lo;
+      if (offset >= 0 && offset < (long long)width * buckets)
+         counts[offset / width]++;
+   }
+}
+
+//-------------------------------  <<  ---------------------------------------
+// display every row the way Employee prints itself
+ostream& operator<<(ostream& output, const EmployeeColumns& store) {
+   for (int row = 0; row < store.size(); row++) {
+      output << setw(4) << store.ids[row] << setw(7) << store.salaries[row]
+             << "  " << store.lastName(row) << " " << store.firstName(row)
+             << endl;
+   }
+   return output;
+}
@@ -0,0 +1,64 @@
+//////////////////////////  employeecolumns.h  ///////////////////////////////
+// Column (struct of arrays) copy of a List<Employee> for reporting
+
+#ifndef EMPLOYEECOLUMNS_H
+#define EMPLOYEECOLUMNS_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "list.h"
+#include "employee.h"
+using namespace std;
+
+//------------------------  class EmployeeColumns  ---------------------------
+// Holds the same employees as a List<Employee>, in the same (name) order,
+// with ids and salaries in their own contiguous int arrays and all names in
+// one string arena. The aggregate methods only touch the int column they
+// need; their loops are plain branch free passes over an int array so the
+// compiler can vectorize them (build with -O3, plus -march=native to use the
+// widest SIMD the machine has).
+//
+// Assumptions:
+//   -- The columns are a snapshot, later changes to the list are not seen.
+//   -- min and max of an empty store are 0.
+//----------------------------------------------------------------------------
+
+class EmployeeColumns {
+   friend ostream& operator<<(ostream&, const EmployeeColumns&);
+
+public:
+   enum Column { ID, SALARY };              // the int columns
+
+   EmployeeColumns();                       // empty store
+   EmployeeColumns(const List<Employee>&);  // snapshot of a list
+
+   void build(const List<Employee>&);       // replace contents with a list
+   void exportTo(List<Employee>&) const;    // insert copies into a list
+   int size() const;                        // number of employees
+
+   // row access
+   int idNumber(int row) const;
+   int salary(int row) const;
+   string lastName(int row) const;
+   string firstName(int row) const;
+
+   // aggregate kernels over one column
+   long long sum(Column) const;
+   int min(Column) const;
+   int max(Column) const;
+   int countRange(Column, int lo, int hi) const;         // lo <= v <= hi
+   int filterRange(Column, int lo, int hi, vector<int>& rows) const;
+   void histogram(Column, int lo, int width, vector<int>& counts) const;
+
+private:
+   vector<int> ids;                         // idNumber column
+   vector<int> salaries;                    // salary column
+   string names;                            // every last and first name
+   vector<int> nameStart;                   // row i: last name starts at
+                                            // [2i], first name at [2i+1]
+
+   const vector<int>& column(Column) const;
+};
+
+#endif
@@ -0,0 +1,178 @@
+/////////////////////////////  indexdriver.cpp  //////////////////////////////
+// Exercises SecondaryIndex: keeps salary and id indexes on two lists of
+// employees through random inserts, removes, merges, intersects, set
+// operations, assignments and makeEmpty, and after every change checks
+// rangeQuery against a filter over the list it indexes. Also times
+// rangeQuery against the filter on one large list.
+//
+//    g++ -std=c++11 -O2 -pthread indexdriver.cpp employee.cpp nodedata.cpp
+//    ./a.out [rounds] [employees]
+//
+// Exits with 1 if a query differs.
+//----------------------------------------------------------------------------
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+using namespace std;
+
+#include "list.h"
+#include "listindex.h"
+#include "employee.h"
+#include "driverutil.h"
+
+const int NAMES = 6;                        // few, so names repeat
+const int SALARIES = 50;                    // salary spread, so keys repeat
+
+typedef SecondaryIndex<Employee, int, EmployeeSalary> SalaryIndex;
+typedef SecondaryIndex<Employee, int, EmployeeId> IdIndex;
+
+const char* const operations[] = { "insert", "remove", "merge", "intersect",
+   "setIntersect", "setUnion", "setDifference", "setSymmetricDifference",
+   "operator=", "makeEmpty" };
+
+//-----------------------------  smallEmployee  ------------------------------
+// ids and salaries below SALARIES, so both keys repeat
+Employee* smallEmployee() {
+   ostringstream last;
+   last << "Last" << rand() % NAMES;
+   return new Employee(last.str(), "F", rand() % SALARIES, rand() % SALARIES);
+}
+
+//------------------------------  filterRange  -------------------------------
+// the items of the list with lo <= key <= hi, by walking it
+template <typename Projection>
+vector<const Employee*> filterRange(const List<Employee>& list, int lo,
+                                    int hi, Projection project) {
+   vector<const Employee*> found;
+   for (List<Employee>::const_iterator it = list.begin(); it != list.end();
+        ++it) {
+      if (lo <= project(*it) && project(*it) <= hi)
+         found.push_back(&*it);
+   }
+   return found;
+}
+
+//--------------------------------  agrees  ----------------------------------
+// a few ranges: the index gives the same items as the filter, in key order.
+// Items with equal keys come out in no set order, so the items are
+// compared as sets once the order of the keys is checked.
+template <typename Projection>
+bool agrees(const SecondaryIndex<Employee, int, Projection>& index,
+            const List<Employee>& list, int spread) {
+   Projection project;
+   if (index.size() != list.size())
+      return false;
+   for (int q = 0; q < 4; q++) {
+      int lo = rand() % spread - 2;
+      int hi = q == 0 ? lo - 1 : lo + rand() % spread;
+      vector<const Employee*> found, expected =
+         filterRange(list, lo, hi, project);
+      if (index.rangeQuery(lo, hi, found) != (int)expected.size())
+         return false;
+      for (size_t i = 1; i < found.size(); i++) {
+         if (project(*found[i]) < project(*found[i - 1]))
+            return false;
+      }
+      sort(found.begin(), found.end());
+      sort(expected.begin(), expected.end());
+      if (found != expected)
+         return false;
+   }
+   return true;
+}
+
+//--------------------------------  change  ----------------------------------
+// one random change of list1, list2 takes part where the operation has two
+// params; the object is now and then one of the params
+int change(List<Employee>& list1, List<Employee>& list2) {
+   int op = rand() % 10;
+   List<Employee> result;
+   List<Employee>& into = rand() % 2 ? list1 : result;
+   switch (op) {
+      case 0: list1.insert(smallEmployee());  break;
+      case 1: {
+         Employee* key = smallEmployee();
+         Employee* gone;
+         if (list1.remove(*key, gone, rand() % 3))
+            delete gone;
+         delete key;
+         break;
+      }
+      case 2: into.merge(list1, list2);  break;
+      case 3: into.intersect(list1, list2);  break;
+      case 4: into.setIntersect(list1, list2);  break;
+      case 5: into.setUnion(list1, list2);  break;
+      case 6: into.setDifference(list1, list2);  break;
+      case 7: into.setSymmetricDifference(list1, list2);  break;
+      case 8: list1 = list2;  break;
+      case 9: list1.makeEmpty();  break;
+   }
+   return op;
+}
+
+//---------------------------------  fill  -----------------------------------
+// size small employees, appended as one sorted run
+void fill(List<Employee>& list, int size) {
+   vector<Employee*> items;
+   for (int i = 0; i < size; i++)
+      items.push_back(smallEmployee());
+   stable_sort(items.begin(), items.end(), lessByName);
+   list.appendRun(items);
+}
+
+int main(int argc, char* argv[]) {
+   int rounds = argc > 1 ? atoi(argv[1]) : 1000;
+   int employees = argc > 2 ? atoi(argv[2]) : 200000;
+   srand(23);
+
+   int failures = 0;
+   for (int round = 0; round < rounds; round++) {
+      List<Employee> list1, list2;
+      fill(list1, rand() % 20);
+      SalaryIndex salaries1(list1);
+      IdIndex ids1(list1);
+      SalaryIndex salaries2(list2);
+      fill(list2, rand() % 20);              // after the index: inserts
+      for (int step = 0; step < 8; step++) {
+         int op = change(list1, list2);
+         if (!agrees(salaries1, list1, SALARIES) ||
+             !agrees(ids1, list1, SALARIES) ||
+             !agrees(salaries2, list2, SALARIES)) {
+            cout << operations[op] << " differs in round " << round << endl;
+            failures++;
+            break;
+         }
+      }
+   }
+   cout << rounds << " random rounds, " << failures << " failed" << endl;
+
+   // timing: narrow salary ranges on one large list, index and filter
+   List<Employee> company;
+   randomList(company, employees, employees / 4 + 1);
+   SalaryIndex bySalary(company);
+   int queries = 200;
+   vector<int> los;
+   for (int q = 0; q < queries; q++)
+      los.push_back(20000 + rand() % 80000);
+   vector<const Employee*> found;
+   int indexed = 0, filtered = 0;
+   TimePoint start = now();
+   for (int q = 0; q < queries; q++)
+      indexed += bySalary.rangeQuery(los[q], los[q] + 100, found);
+   double indexTime = seconds(start);
+   start = now();
+   for (int q = 0; q < queries; q++)
+      filtered += filterRange(company, los[q], los[q] + 100,
+                              EmployeeSalary()).size();
+   double filterTime = seconds(start);
+   failures += indexed != filtered;
+   cout << company.size() << " employees, " << queries
+        << " range queries  index " << indexTime << "s  filter "
+        << filterTime << "s" << endl;
+
+   cout << failures << " failures" << endl;
+   return failures == 0 ? 0 : 1;
+}
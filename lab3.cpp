@@ -174,17 +174,17 @@ int main() {
 
    cout << "test remove and retrieve on 4" << endl;
    cout << "-----------------------------" << endl;
-   Employee emp3("Andrew", "Jackson");
-   Employee emp4("Peter", "Hawkins");
+   EmployeeName emp3("Andrew", "Jackson");
+   EmployeeName emp4("Peter", "Hawkins");
    success = company4.retrieve(emp3, oneEmployee);
    if (success) cout << "Found in list:  " << *oneEmployee << endl;
    else         cout << "Did not find andrew in list" << endl;
    success = company4.retrieve(emp4, oneEmployee);
    if (success) cout << "Found in list:  " << *oneEmployee << endl;
    else         cout << "Did not find peter in list" << endl;
-   Employee emp5("Verena", "George");
-   Employee emp6("David", "Edward");
-   Employee emp7("Thomas", "Edison");
+   EmployeeName emp5("Verena", "George");
+   EmployeeName emp6("David", "Edward");
+   EmployeeName emp7("Thomas", "Edison");
    success = company4.remove(emp5, oneEmployee);
    if (success) {
       cout << "Removed:  " << *oneEmployee << endl;
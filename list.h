@@ -6,11 +6,17 @@
 
 #include <iostream>
 #include <fstream>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+#include <algorithm>
+#include <thread>
 using namespace std;
 
 //--------------------------  class List  ------------------------------------
 // ADT List: finite, ordered collection of zero or more items.
-//           The ordering is determined by operator< of T class.
+//           The ordering is determined by T's three way compare, or
+//           operator< of T class when it has none (see listCompare).
 //
 // Assumptions:
 //   -- Control of <, printing, etc. of T information is in the T class.
@@ -18,19 +24,164 @@ using namespace std;
 //      If the list is empty, head is NULL.
 //   -- The insert allocates memory for a Node, ptr to the data is passed in.
 //      Allocating memory and setting data is the responsibility of the caller.
+//   -- remove gives the item back to the caller, who deletes it (or inserts
+//      it elsewhere). extract and splice move whole nodes between lists
+//      without allocating.
+//   -- How a Node holds its item is picked at compile time by ListInline<T>
+//      (see ListNode below): trivially copyable items are kept inside the
+//      node, anything else stays on the heap with the node pointing to it.
+//   -- The list keeps its element count and a fingerprint (sum of the mixed
+//      hashValue of every item) up to date, so size() is O(1) and most
+//      unequal lists are rejected by operator== without walking them.
+//      Data reached through retrieve must not be changed in a way that
+//      changes its ordering or equality while it is in the list.
+//   -- Companion structures (indexes and the like) register a ListObserver
+//      and are told about every item that enters or leaves the list.
 //
 // Note this definition is not a complete class and is not fully documented.
 //----------------------------------------------------------------------------
 
+//----------------------------------------------------------------------------
+// listCompare
+// three way comparison used by every List algorithm: negative, zero or
+// positive as a is less than, equal to or greater than b, decided in one
+// pass. Types with an int compare(const K&) const member (Employee,
+// NodeData) use it; types that only have operator< fall back to at most
+// two calls of it, equal meaning neither is less. b may be a lighter key
+// type than a (EmployeeName for Employee), which is how the lookups below
+// avoid building a whole T to search with.
+template <typename T, typename K>
+auto listCompare(const T& a, const K& b, int) -> decltype(int(a.compare(b))) {
+   return a.compare(b);
+}
+
+template <typename T, typename K>
+int listCompare(const T& a, const K& b, long) {
+   return a < b ? -1 : (b < a ? 1 : 0);
+}
+
+template <typename T, typename K>
+int listCompare(const T& a, const K& b) {
+   return listCompare(a, b, 0);
+}
+
+//----------------------------------------------------------------------------
+// hashValue
+// default fingerprint contribution for a type that does not supply its own
+// hashValue; a constant keeps operator== correct, it just never rejects early.
+// Types provide a non-template overload (found through ADL) that hashes
+// exactly the fields their operator== compares.
+template <typename T>
+unsigned long hashValue(const T&) {
+   return 0;
+}
+
+//--------------------------  ListInline  ------------------------------------
+// Storage policy for List<T>. Items that are trivially copyable (NodeData)
+// are stored inside the node and copied with memcpy, other items (Employee)
+// are kept on the heap. Specialize for a type to force the heap layout;
+// inline storage memcpys the item, so only trivially copyable types get it.
+template <typename T>
+struct ListInline : integral_constant<bool, is_trivially_copyable<T>::value> {
+};
+
+//---------------------------  ListNode  -------------------------------------
+// the node in a linked list, default layout: pointer to the heap item
+template <typename T, bool Inline = ListInline<T>::value>
+struct ListNode {
+   T* data;                 // pointer to actual data, operations in T
+   ListNode* next;
+
+   T& item() const { return *data; }
+
+   // link the node to data allocated by the caller, node now owns it
+   void take(T* ptr) { data = ptr; }
+
+   // give a new node its own copy of another node's data
+   void copyFrom(const ListNode& other) {
+      data = new T;
+      *data = *other.data;
+   }
+
+   // the data remove hands back through its T*& parameter, the node no
+   // longer owns it
+   T* handOut() {
+      T* ptr = data;
+      data = NULL;
+      return ptr;
+   }
+
+   static void destroy(ListNode* node) {
+      if (node->data != NULL)
+         delete node->data;
+      delete node;
+   }
+};
+
+//---------------------------  ListNode  -------------------------------------
+// inline layout: the item lives in the node, no separate allocation per item
+template <typename T>
+struct ListNode<T, true> {
+   static_assert(is_trivially_copyable<T>::value,
+                 "inline List nodes memcpy their item");
+
+   T value;                 // the actual data, operations in T
+   ListNode* next;
+
+   T& item() const { return const_cast<T&>(value); }
+
+   // the caller's heap object is copied into the node and freed
+   void take(T* ptr) {
+      memcpy(static_cast<void*>(&value), ptr, sizeof(T));
+      delete ptr;
+   }
+
+   void copyFrom(const ListNode& other) {
+      memcpy(static_cast<void*>(&value), &other.value, sizeof(T));
+   }
+
+   // the item dies with its node, so the caller gets a heap copy to own
+   T* handOut() {
+      T* ptr = new T;
+      memcpy(static_cast<void*>(ptr), &value, sizeof(T));
+      return ptr;
+   }
+
+   static void destroy(ListNode* node) {
+      delete node;
+   }
+};
+
+//--------------------------  ListObserver  ----------------------------------
+// Interface for structures kept in step with a List<T>. The list calls
+// inserted once an item is linked in, with the number of items equal to it
+// that are ahead of it (items arriving together are reported in list order,
+// each once it is in place), removed just before an item is deleted and
+// cleared just before every item goes at once; merge, intersect and the set
+// operations report their results through the same calls.
+// The references stay valid until the matching removed or cleared.
+// detached is called when the list is destroyed, instead of cleared: the
+// items are still there during the call and go without further notice.
+template <typename T>
+class ListObserver {
+public:
+   virtual ~ListObserver() { }
+   virtual void inserted(const T&, int equalAhead) = 0;
+   virtual void removed(const T&) = 0;
+   virtual void cleared() = 0;
+   virtual void detached() = 0;
+};
+
 template <typename T>
 class List {
+   typedef ListNode<T> Node;   // layout chosen by ListInline<T>
 
    // output operator for class List, print data,
    // responsibility for output is left to object stored in the list
    friend ostream& operator<<(ostream& output, const List<T>& thelist) {
       typename List<T>::Node* current = thelist.head;
       while (current != NULL) {
-         output << *current->data;
+         output << current->item();
          current = current->next;
       }
       return output;
@@ -44,28 +195,153 @@ public:
    bool operator==(const List&) const;      // Checks if 2 lists are equal
    bool operator!=(const List&) const;      // Checks if 2 lists are not equal
    bool insert(T*);                         // insert one Node into list
-   bool remove(const T&, T*&);              // removes the given node from the
-                                            //list
-   bool retrieve(const T&, T*&) const;      // Retrieves the given data
+   bool insert(T*, int equalAhead);         // insert behind that many equal
+                                            // items (all if there are fewer)
+   void appendRun(const vector<T*>&);       // insert items already in order,
+                                            // O(1) each past the last item
+   // the lookups take any key K that listCompare(const T&, const K&) accepts,
+   // T itself or a key type such as EmployeeName
+   template <typename K>
+   bool remove(const K&, T*&, int skip = 0);  // removes the given node from
+                                            //the list, caller owns the item;
+                                            //skip passes over equal items
+   template <typename K>
+   bool retrieve(const K&, T*&) const;      // Retrieves the given data
+   void retrieveMany(const vector<T>&, vector<T*>&) const;  // retrieve for
+                                            // every probe in one pass
+   void containsMany(const vector<T>&, vector<bool>&) const;
    bool isEmpty() const;                    // is list empty?
+   int size() const;                        // number of items, O(1)
    void buildList(ifstream&);               // build a list from datafile
    void merge(List&, List&);                // merges 2 lists together leaving
                                             // the given ones empty.
    void intersect(List&, List&);            //finds in common data in both
                                             //lists leaving both unchanged.
+   void parallelMerge(List&, List&, int threads = 0);      // same result as
+   void parallelIntersect(List&, List&, int threads = 0);  // merge/intersect,
+                                            // split by key across threads
    void copy(const List&);                  // copy method used in copy Cnst &
                                             //operator=
+
+   // destructive set operations, relink the nodes of both lists into the
+   // object leaving both empty; the result holds each item once
+   void setIntersect(List&, List&);         // items in both lists
+   void setUnion(List&, List&);             // items in either list
+   void setDifference(List&, List&);        // items in 1st but not 2nd
+   void setSymmetricDifference(List&, List&);  // items in exactly one list
    void makeEmpty();                        // deletes memory of object.
 
+   // a node taken out of a list with its item, owned by the handle until
+   // it is inserted into a list again (or deleted with the handle)
+   class NodeHandle {
+   public:
+      NodeHandle() : node(NULL) { }
+      NodeHandle(NodeHandle&& other) : node(other.node) { other.node = NULL; }
+      NodeHandle& operator=(NodeHandle&& other) {
+         if (this != &other) {
+            if (node != NULL) Node::destroy(node);
+            node = other.node;
+            other.node = NULL;
+         }
+         return *this;
+      }
+      ~NodeHandle() { if (node != NULL) Node::destroy(node); }
+      bool empty() const { return node == NULL; }
+      T& value() const { return node->item(); }
+   private:
+      friend class List;
+      explicit NodeHandle(Node* n) : node(n) { }
+      NodeHandle(const NodeHandle&);                 // not copyable
+      NodeHandle& operator=(const NodeHandle&);
+      Node* node;
+   };
+   template <typename K>
+   NodeHandle extract(const K&);            // unlinks first equal item
+   bool insert(NodeHandle&&);               // links an extracted node
+   void splice(List&, const T& lo, const T& hi);  // moves from's items in
+                                            // [lo, hi] into the object
+
+   void addObserver(ListObserver<T>*);      // start reporting changes
+   void removeObserver(ListObserver<T>*);   // stop reporting changes
+
+   // read only walk over the items in order, for companion containers
+   class const_iterator {
+   public:
+      const_iterator(Node* node = NULL) : current(node) { }
+      const T& operator*() const { return current->item(); }
+      const T* operator->() const { return &current->item(); }
+      const_iterator& operator++() { current = current->next; return *this; }
+      bool operator==(const const_iterator& other) const
+         { return current == other.current; }
+      bool operator!=(const const_iterator& other) const
+         { return current != other.current; }
+   private:
+      Node* current;
+   };
+   const_iterator begin() const { return const_iterator(head); }
+   const_iterator end() const { return const_iterator(); }
+   template <typename K>
+   const_iterator lowerBound(const K&) const;  // first item not less than
+                                            // the key, end() if none
+
    // needs many more member functions to become a complete ADT
 
 private:
-   struct Node {            // the node in a linked list
-      T* data;              // pointer to actual data, operations in T
-      Node* next;
-   };
 
    Node* head;              // pointer to first node in list
+   int count;               // number of nodes in list
+   unsigned long fingerprint;  // sum of mix(hashValue) over all items
+
+   static unsigned long mix(unsigned long);  // spreads hashValue bits
+   static void freeChain(Node*);            // deletes a chain of nodes
+   void link(Node*);                        // sorted insert of one node
+   template <typename K>
+   Node* unlink(const K&, int skip = 0);    // detach first equal node, after
+                                            // passing over skip of them
+   void linkBehind(Node*, int);             // link after n equal nodes
+   void relink(List&, List&, bool, bool, bool);  // shared set operation pass
+
+   vector<ListObserver<T>*> observers;      // told about every change,
+                                            // not copied with the list
+   void notifyInserted(Node*, Node*, int) const;  // report nodes up to
+                                            // 2nd as inserted, the 1st with
+                                            // int equal items ahead
+   void notifyGained(const vector<Node*>&) const;  // report nodes merged in
+   void notifyRemoved(Node*) const;         // report one node as removed
+   void notifyCleared() const;              // report every item as gone
+
+   // one key range of both lists, worked on by one thread
+   struct Partition {
+      Node* start;          // first node of the range in the 1st list
+      Node* stop;           // first node past the range in the 1st list
+      Node* start2;         // same for the 2nd list
+      Node* stop2;
+      Node* first;          // result chain, NULL if empty
+      Node* last;
+      int count;            // items in the result chain
+      unsigned long fingerprint;
+   };
+   static const int PARALLEL_MIN = 16384;   // smaller inputs stay serial
+   static int threadCount(int);
+   static void sample(Node*, int, int, vector<Node*>&);
+   static Node* lowerBound(const vector<Node*>&, const T&);
+   void partition(List&, List&, int, vector<Partition>&);
+   static void mergePartition(Partition*);
+   static void intersectPartition(Partition*);
+
+   // orders node pointers by their items
+   struct NodeLess {
+      bool operator()(const Node* a, const Node* b) const
+         { return listCompare(a->item(), b->item()) < 0; }
+   };
+
+   // orders positions in a probe vector by the probes they refer to
+   struct ProbeLess {
+      const vector<T>& probes;
+      ProbeLess(const vector<T>& p) : probes(p) { }
+      bool operator()(size_t a, size_t b) const
+         { return listCompare(probes[a], probes[b]) < 0; }
+   };
 };
 
 
@@ -74,6 +350,8 @@ private:
 template <typename T>
 List<T>::List() {
    head = NULL;
+   count = 0;
+   fingerprint = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -81,6 +359,11 @@ List<T>::List() {
 template <typename T>
 List<T>::~List()
 {
+    //the observers are let go first, so freeing the nodes is not reported
+    //as a makeEmpty (a journal would record it as one)
+    for (size_t i = 0; i < observers.size(); i++)
+        observers[i]->detached();
+    observers.clear();
     makeEmpty();
 }
 
@@ -120,6 +403,10 @@ bool List<T>::operator==(const List& list) const
     //if calling object is the parameter
     if (this == &list)
         return true;
+    //lists with different lengths or contents can't be equal, only walk
+    //the lists when the count and fingerprint both match.
+    if (count != list.count || fingerprint != list.fingerprint)
+        return false;
     
     Node* cur = head;
     Node* cur2 = list.head;
@@ -128,7 +415,7 @@ bool List<T>::operator==(const List& list) const
     while (cur != NULL && cur2 != NULL)
     {
         //returning false if not equal
-        if (*cur->data != *cur2->data)
+        if (listCompare(cur->item(), cur2->item()) != 0)
             return false;
         
         //next pointer in curs
@@ -160,11 +447,94 @@ bool List<T>::insert(T* dataptr) {
 
    Node* ptr= new Node;
    if (ptr == NULL) return false;                 // out of memory, bail
-   ptr->data = dataptr;                           // link the node to data
+   ptr->take(dataptr);                            // link the node to data
+   link(ptr);
+   return true;
+}
+
+//----------------------------------------------------------------------------
+// insert
+// insert an item with exactly equalAhead equal items in front of it (or
+// after all of them when there are fewer), so the order of equal items can
+// be rebuilt as it was; ListJournal replays inserts this way
+template <typename T>
+bool List<T>::insert(T* dataptr, int equalAhead) {
+
+   Node* ptr = new Node;
+   if (ptr == NULL) return false;                 // out of memory, bail
+   ptr->take(dataptr);
+   linkBehind(ptr, equalAhead);
+   return true;
+}
+
+//----------------------------------------------------------------------------
+// appendRun
+// inserts items that are already in sorted order, taking them like insert.
+// Each one is placed by a walk that starts where the one before it went, so
+// a run into an empty list (or past every item already here) costs O(1) per
+// item. Equal items keep their order in the run and go after equal items
+// already in the list. An item smaller than the one before it is placed by
+// a walk from the head, so an unsorted run still gives a sorted list.
+template <typename T>
+void List<T>::appendRun(const vector<T*>& run) {
+   Node* previous = NULL;                   // last node placed, NULL at head
+   Node* current = head;                    // node after previous
+   int ahead = 0;                           // items equal to previous's up
+                                            // to and without it
+   for (size_t i = 0; i < run.size(); i++) {
+      Node* ptr = new Node;
+      ptr->take(run[i]);
+      int order = 0;
+      if (previous != NULL &&
+          (order = listCompare(ptr->item(), previous->item())) < 0) {
+         previous = NULL;
+         current = head;
+      }
+      ahead = (previous != NULL && order == 0 ? ahead + 1 : 0);
+      while (current != NULL &&
+             (order = listCompare(current->item(), ptr->item())) <= 0) {
+         ahead = (order == 0 ? ahead + 1 : 0);
+         previous = current;
+         current = current->next;
+      }
+
+      ptr->next = current;
+      if (previous == NULL)
+         head = ptr;
+      else
+         previous->next = ptr;
+      previous = ptr;
+      count++;
+      fingerprint += mix(hashValue(ptr->item()));
+      notifyInserted(ptr, current, ahead);
+   }
+}
+
+//----------------------------------------------------------------------------
+// insert
+// links a node taken out of this or another list back in by its item,
+// nothing is allocated; the handle is left empty
+template <typename T>
+bool List<T>::insert(NodeHandle&& handle) {
+   if (handle.node == NULL) return false;
+   Node* ptr = handle.node;
+   handle.node = NULL;
+   link(ptr);
+   return true;
+}
+
+//----------------------------------------------------------------------------
+// link
+// puts a node holding an item in its sorted place, before equal items
+// unless the first of them is the head, then right after the head
+template <typename T>
+void List<T>::link(Node* ptr) {
+   count++;
+   fingerprint += mix(hashValue(ptr->item()));
 
    // if the list is empty or if the node should be inserted before
    // the first node of the list
-   if (isEmpty() || *ptr->data < *head->data) {
+   if (isEmpty() || listCompare(ptr->item(), head->item()) < 0) {
       ptr->next = head;
       head = ptr;
    }
@@ -175,7 +545,7 @@ bool List<T>::insert(T* dataptr) {
       Node* previous = head;               // to walk list, lags behind
 
       // walk until end of the list or found position to insert
-      while (current != NULL && *current->data < *ptr->data) {
+      while (current != NULL && listCompare(current->item(), ptr->item()) < 0) {
             previous = current;                  // walk to next node
             current = current->next;
       }
@@ -184,82 +554,277 @@ bool List<T>::insert(T* dataptr) {
       ptr->next = current;
       previous->next = ptr;
    }
-   return true;
+   // only the head can be an equal item ahead of it
+   int ahead = (ptr != head && listCompare(head->item(), ptr->item()) == 0
+                ? 1 : 0);
+   notifyInserted(ptr, ptr->next, ahead);
+}
+
+//----------------------------------------------------------------------------
+// linkBehind
+// puts a node after the first equalAhead nodes equal to it, or after all
+// of them when there are fewer
+template <typename T>
+void List<T>::linkBehind(Node* ptr, int equalAhead) {
+   count++;
+   fingerprint += mix(hashValue(ptr->item()));
+
+   Node* previous = NULL;                   // NULL while at the head
+   Node* current = head;
+   int order = 0;
+   int ahead = 0;                           // equal nodes passed
+   while (current != NULL &&
+          ((order = listCompare(current->item(), ptr->item())) < 0 ||
+           (order == 0 && ahead < equalAhead))) {
+      if (order == 0)
+         ahead++;
+      previous = current;
+      current = current->next;
+   }
+
+   ptr->next = current;
+   if (previous == NULL)
+      head = ptr;
+   else
+      previous->next = ptr;
+   notifyInserted(ptr, current, ahead);
 }
 
 //----------------------------------------------------------------------------
 //remove
-//removes the given node from the list and returns true
-template<typename T>
-bool List<T>::remove(const T& target, T*& p)
+//removes the given node from the list and returns true. The item goes to
+//the caller through p, who is now responsible for deleting it. With skip,
+//that many equal items are passed over first, to pick one of several.
+template <typename T>
+template <typename K>
+bool List<T>::remove(const K& target, T*& p, int skip)
 {
-    if (isEmpty())
+    Node* temp = unlink(target, skip);
+    //if target isn't found, p is null and then return false.
+    if (temp == NULL)
+    {
+        p = NULL;
         return false;
+    }
+    p = temp->handOut();
+    Node::destroy(temp);
+    return true;
+}
+
+//----------------------------------------------------------------------------
+//extract
+//takes the node of the first item equal to target out of the list and
+//hands it over whole; the handle is empty if target isn't found
+template <typename T>
+template <typename K>
+typename List<T>::NodeHandle List<T>::extract(const K& target)
+{
+    return NodeHandle(unlink(target));
+}
+
+//----------------------------------------------------------------------------
+//unlink
+//takes the node of the first item equal to target (after skipping skip of
+//them) out of the chain, NULL if there is none
+template <typename T>
+template <typename K>
+typename List<T>::Node* List<T>::unlink(const K& target, int skip)
+{
+    //walking until the first item not less than target, the list is sorted
+    //so target can't be any further on.
+    Node* previous = NULL;
+    Node* temp = head;
+    int order = 1;
+    while (temp != NULL &&
+           ((order = listCompare(temp->item(), target)) < 0 ||
+            (order == 0 && skip > 0)))
+    {
+        if (order == 0)
+            skip--;
+        previous = temp;
+        temp = temp->next;
+    }
+    if (temp == NULL || order != 0)
+        return NULL;
+    
+    if (previous == NULL)
+        head = temp->next;
+    else
+        previous->next = temp->next;
+    
+    count--;
+    fingerprint -= mix(hashValue(temp->item()));
+    notifyRemoved(temp);
+    temp->next = NULL;
+    return temp;
+}
+
+//----------------------------------------------------------------------------
+//splice
+//moves every item of from with lo <= item <= hi into the object. The run
+//is cut out of from in one piece and its nodes are linked in where they
+//belong (after equal items already here), so nothing is allocated or
+//copied. The cost is not just the run: from is walked from its head to the
+//end of the run, and the object from its head to where the last run item
+//goes, since a singly linked list can only find a place by walking to it.
+//That is O(n + m) in the worst case, for a run near the end of either.
+template <typename T>
+void List<T>::splice(List& from, const T& lo, const T& hi)
+{
+    if (this == &from || from.isEmpty())
+        return;
     
-    //checking if the head is the target value
-    if (*head->data == target)
+    //finding the run: before is the node ahead of it (NULL at head)
+    Node* before = NULL;
+    Node* first = from.head;
+    while (first != NULL && listCompare(first->item(), lo) < 0)
     {
-        p = head->data; //setting the data to p and the walking had to delete the node.
-        Node* temp = head;
-        head = head->next;
-        
-        if (temp->data != NULL)
-            delete temp->data;
-        
-        delete temp;
-        return true;
+        before = first;
+        first = first->next;
+    }
+    if (first == NULL || listCompare(hi, first->item()) < 0)
+        return;
+    
+    Node* last = first;
+    int runCount = 1;
+    unsigned long runFingerprint = mix(hashValue(first->item()));
+    while (last->next != NULL && listCompare(last->next->item(), hi) <= 0)
+    {
+        last = last->next;
+        runCount++;
+        runFingerprint += mix(hashValue(last->item()));
     }
     
-    Node* cur = head;
+    //cutting the run out of from
+    for (Node* cur = first; cur != last->next; cur = cur->next)
+        from.notifyRemoved(cur);
+    if (before == NULL)
+        from.head = last->next;
+    else
+        before->next = last->next;
+    last->next = NULL;
+    from.count -= runCount;
+    from.fingerprint -= runFingerprint;
+    count += runCount;
+    fingerprint += runFingerprint;
     
-    while (cur->next != NULL) //walking the next so we change the next to the node after
-    {                         //the one we want to remove.
-        if (*cur->next->data == target)
+    //merging the run into the object, existing items first on ties; each
+    //node is reported once it is in place
+    Node* prev = NULL;
+    Node* cur = head;
+    Node* run = first;
+    int ahead = 0;                          //items equal to run's passed
+    while (run != NULL)
+    {
+        int order;
+        if (cur != NULL &&
+            (order = listCompare(cur->item(), run->item())) <= 0)
         {
-            p = cur->next->data;
-            Node* temp = cur->next;
-            cur->next = cur->next->next;
-            //data could be null.
-            if (temp->data != NULL)
-                delete temp->data;
-            
-            delete temp;
-            return true;
+            ahead = (order == 0 ? ahead + 1 : 0);
+            prev = cur;
+            cur = cur->next;
+            continue;
         }
-        
-        cur = cur->next;
+        Node* next = run->next;
+        run->next = cur;
+        if (prev == NULL)
+            head = run;
+        else
+            prev->next = run;
+        prev = run;
+        run = next;
+        notifyInserted(prev, cur, ahead);
+        ahead = (run != NULL && listCompare(prev->item(), run->item()) == 0
+                 ? ahead + 1 : 0);
     }
-    //if target isn't found, p is null and then return false.
-    p = NULL;
-    return false;
 }
 
 //----------------------------------------------------------------------------
 //retrieve
 //retrieves a given target without deleting it from the list
 template <typename T>
-bool List<T>::retrieve(const T& target, T*& p) const
+template <typename K>
+bool List<T>::retrieve(const K& target, T*& p) const
 {
-    if (isEmpty())
-        return false;
-    
     Node* cur = head;
-    //going until node is found and returning.
-    while (cur != NULL)
-    {
-        if (*cur->data == target)
-        {
-            p = cur->data;
-            return true;
-        }
-        
+    //going until the first item not less than target, which is the one if
+    //target is in the list at all.
+    int order = 1;
+    while (cur != NULL && (order = listCompare(cur->item(), target)) < 0)
         cur = cur->next;
+    
+    if (cur != NULL && order == 0)
+    {
+        p = &cur->item();
+        return true;
     }
     //if target isn't found, set p to null and then return false.
     p = NULL;
     return false;
 }
 
+//----------------------------------------------------------------------------
+//lowerBound
+//the first item not less than key, so a walk from it visits every item
+//from key onwards; end() when every item is less
+template <typename T>
+template <typename K>
+typename List<T>::const_iterator List<T>::lowerBound(const K& key) const
+{
+    Node* cur = head;
+    while (cur != NULL && listCompare(cur->item(), key) < 0)
+        cur = cur->next;
+    return const_iterator(cur);
+}
+
+//----------------------------------------------------------------------------
+//retrieveMany
+//found[i] is what retrieve would give for probes[i] (NULL if not found).
+//The probes are put in order (unless they already are) and matched against
+//the list in one merge style walk, O(n + m log m) for m probes instead of
+//a walk from head for each one.
+template <typename T>
+void List<T>::retrieveMany(const vector<T>& probes, vector<T*>& found) const
+{
+    found.assign(probes.size(), NULL);
+    
+    //positions of the probes in sorted order, only sorted when needed
+    vector<size_t> order(probes.size());
+    for (size_t i = 0; i < order.size(); i++)
+        order[i] = i;
+    bool sorted = true;
+    for (size_t i = 1; i < probes.size() && sorted; i++)
+        sorted = listCompare(probes[i - 1], probes[i]) <= 0;
+    if (!sorted)
+        stable_sort(order.begin(), order.end(), ProbeLess(probes));
+    
+    //cur never moves back, it stops at the first item not less than the
+    //probe, which is the one retrieve would find if it is equal.
+    Node* cur = head;
+    for (size_t i = 0; i < order.size() && cur != NULL; i++)
+    {
+        const T& probe = probes[order[i]];
+        int result = 1;
+        while (cur != NULL && (result = listCompare(cur->item(), probe)) < 0)
+            cur = cur->next;
+        if (cur != NULL && result == 0)
+            found[order[i]] = &cur->item();
+    }
+}
+
+//----------------------------------------------------------------------------
+//containsMany
+//found[i] says whether probes[i] is in the list, same single walk
+template <typename T>
+void List<T>::containsMany(const vector<T>& probes, vector<bool>& found) const
+{
+    vector<T*> items;
+    retrieveMany(probes, items);
+    found.resize(items.size());
+    for (size_t i = 0; i < items.size(); i++)
+        found[i] = (items[i] != NULL);
+}
+
 //----------------------------------------------------------------------------
 // isEmpty
 // check to see if List is empty as defined by a NULL head
@@ -268,6 +833,28 @@ bool List<T>::isEmpty() const {
    return head == NULL;
 }
 
+//----------------------------------------------------------------------------
+// size
+// number of items in the list, kept up to date by every operation
+template <typename T>
+int List<T>::size() const {
+   return count;
+}
+
+//----------------------------------------------------------------------------
+// mix
+// finalizer applied to each hashValue before it is added to the fingerprint,
+// so that simple per-type hashes don't cancel each other out in the sum
+template <typename T>
+unsigned long List<T>::mix(unsigned long h) {
+   h ^= h >> 33;
+   h *= 0xff51afd7ed558ccdUL;
+   h ^= h >> 33;
+   h *= 0xc4ceb9fe1a85ec53UL;
+   h ^= h >> 33;
+   return h;
+}
+
 //----------------------------------------------------------------------------
 // buildList
 // continually insert new items into the list
@@ -346,11 +933,27 @@ void List<T>::merge(List& list1, List& list2)
         return;
     }
     
+    //telling the observers: the params lose all their items, and when the
+    //object is one of them it gains the other's nodes. Those are reported
+    //once they are linked in, in list order, so an observer can see where
+    //each one went.
+    if (this != &list1)
+        list1.notifyCleared();
+    if (this != &list2)
+        list2.notifyCleared();
+    vector<Node*> gained;
+    if (!observers.empty() && (this == &list1 || this == &list2))
+    {
+        for (Node* cur = (this == &list1 ? list2.head : list1.head);
+             cur != NULL; cur = cur->next)
+            gained.push_back(cur);
+    }
+    
     Node* fakeHead;
 
     //checking the data of cur with cur2 if it's less or equal since there
-    //could be duplicates.
-    if (*list1.head->data <= *list2.head->data)
+    //could be duplicates; one three way compare decides both cases.
+    if (listCompare(list1.head->item(), list2.head->item()) <= 0)
     {
         //setting fakehead to cur and then giving fakehead a next pointer
         //setting it to null and traversing it as well as cur.
@@ -358,9 +961,8 @@ void List<T>::merge(List& list1, List& list2)
         list1.head = list1.head->next;
         fakeHead->next = NULL;
     }
-    //same logic as previous if statement. Using else if statement so it is
-    //skipped if there are duplicates
-    else if (*list2.head->data < *list1.head->data)
+    //cur2's data is < cur's data
+    else
     {
         fakeHead = list2.head;
         list2.head = list2.head->next;
@@ -368,6 +970,11 @@ void List<T>::merge(List& list1, List& list2)
     }
     
     
+    //the merged list holds every node of both lists, and the fingerprint
+    //is a sum, so both can be totaled before the walk.
+    int mergedCount = list1.count + list2.count;
+    unsigned long mergedFingerprint = list1.fingerprint + list2.fingerprint;
+
     //pointer to fakeHead to traverse and setting the next.
     Node* p = fakeHead;
     Node* cur = list1.head;
@@ -375,7 +982,7 @@ void List<T>::merge(List& list1, List& list2)
     
     while (cur != NULL && cur2 != NULL)
     {
-        if (*cur->data <= *cur2->data)
+        if (listCompare(cur->item(), cur2->item()) <= 0)
         {
             //starting at p->next since p points to fakeHead which has one node
             //already. Then we traverse so it's pointing to it.
@@ -384,7 +991,7 @@ void List<T>::merge(List& list1, List& list2)
             cur = cur->next;
         }
         
-        else if (*cur2->data < *cur->data)
+        else //cur2's data is < cur's data
         {
             p->next = cur2;
             p = p->next;
@@ -414,13 +1021,20 @@ void List<T>::merge(List& list1, List& list2)
             cur = cur->next;
         }
     }
-    //emptying object so we set it to fakeHead
-    makeEmpty();
-    //leaving the parameters' head to null
+    //leaving the parameters' head to null first, so when the object is one
+    //of the parameters makeEmpty doesn't delete the merged nodes.
     list1.head = NULL;
     list2.head = NULL;
+    list1.count = list2.count = 0;
+    list1.fingerprint = list2.fingerprint = 0;
+    //emptying object so we set it to fakeHead
+    makeEmpty();
     head = fakeHead;
-
+    count = mergedCount;
+    fingerprint = mergedFingerprint;
+    if (this != &list1 && this != &list2)
+        notifyInserted(head, NULL, 0);
+    notifyGained(gained);
 }
 
 //----------------------------------------------------------------------------
@@ -454,9 +1068,11 @@ void List<T>::intersect(List& list1, List& list2)
         return;
     }
     
-    Node* fakeHead;
+    Node* fakeHead = NULL;
     Node* cur = list1.head;
     Node* cur2 = list2.head;
+    int commonCount = 0;
+    unsigned long commonFingerprint = 0;
     
     //iterating until both are null since after one is null, there is no more intersections
     while (cur != NULL && cur2 != NULL)
@@ -464,18 +1080,20 @@ void List<T>::intersect(List& list1, List& list2)
         //dereferencing the datas and checking if they're equal, and creating a new node
         //for head and new Tsand setting it to the data of cur (same as cur2).
         //then walking the curs.
-        if (*cur->data == *cur2->data)
+        int order = listCompare(cur->item(), cur2->item());
+        if (order == 0)
         {
             fakeHead = new Node;
-            fakeHead->data = new T;
-            *fakeHead->data = *cur->data;
+            fakeHead->copyFrom(*cur);
             fakeHead->next = NULL;
+            commonCount++;
+            commonFingerprint += mix(hashValue(fakeHead->item()));
             cur = cur->next;
             cur2 = cur2->next;
             break;
         }
         
-        if (*cur->data < *cur2->data)
+        if (order < 0)
         {
             cur = cur->next;
         }
@@ -489,21 +1107,23 @@ void List<T>::intersect(List& list1, List& list2)
     
         while (cur != NULL && cur2 != NULL)
         {
-            if (*cur->data == *cur2->data)
+            int order = listCompare(cur->item(), cur2->item());
+            if (order == 0)
             {
                 //starting with p's next since p is pointing to fakeHead which
                 //should have one node already from previous loop.
                 p->next = new Node;
                 p = p->next;
                 p->next = NULL;
-                p->data = new T;
-                *p->data = *cur->data;
+                p->copyFrom(*cur);
+                commonCount++;
+                commonFingerprint += mix(hashValue(p->item()));
                 cur = cur->next;
                 cur2 = cur2->next;
                 continue;
             }
         
-            if (*cur->data < *cur2->data)
+            if (order < 0)
             {
                 cur = cur->next;
             }
@@ -516,19 +1136,312 @@ void List<T>::intersect(List& list1, List& list2)
     makeEmpty();
     
     head = fakeHead;
+    count = commonCount;
+    fingerprint = commonFingerprint;
+    notifyInserted(head, NULL, 0);
+}
+//----------------------------------------------------------------------------
+//parallelMerge
+//gives the same list as merge (list1's item first on ties, params left
+//empty), with the work spread over threads (0 means one per core). Both
+//lists are cut at the same splitter keys, sampled from both, so every
+//partition merges a key range of list1 with the same range of list2 on its
+//own thread; the partition results are then joined end to end. Small
+//inputs and the special cases (empty or same list) use merge itself.
+//The ordering must be a strict weak order that agrees with ==.
+template <typename T>
+void List<T>::parallelMerge(List& list1, List& list2, int threads)
+{
+    threads = threadCount(threads);
+    if (threads < 2 || &list1 == &list2 || list1.isEmpty() ||
+        list2.isEmpty() || list1.count + list2.count < PARALLEL_MIN ||
+        list1 == list2)
+    {
+        merge(list1, list2);
+        return;
+    }
+    
+    //observers hear the same as from merge
+    if (this != &list1)
+        list1.notifyCleared();
+    if (this != &list2)
+        list2.notifyCleared();
+    vector<Node*> gained;
+    if (!observers.empty() && (this == &list1 || this == &list2))
+    {
+        for (Node* cur = (this == &list1 ? list2.head : list1.head);
+             cur != NULL; cur = cur->next)
+            gained.push_back(cur);
+    }
+    
+    int mergedCount = list1.count + list2.count;
+    unsigned long mergedFingerprint = list1.fingerprint + list2.fingerprint;
+    
+    vector<Partition> parts;
+    partition(list1, list2, threads, parts);
+    vector<thread> workers;
+    for (size_t i = 1; i < parts.size(); i++)
+        workers.push_back(thread(mergePartition, &parts[i]));
+    mergePartition(&parts[0]);
+    for (size_t i = 0; i < workers.size(); i++)
+        workers[i].join();
+    
+    //joining the partition chains in order
+    Node* fakeHead = NULL;
+    Node* tail = NULL;
+    for (size_t i = 0; i < parts.size(); i++)
+    {
+        if (parts[i].first == NULL)
+            continue;
+        if (tail == NULL)
+            fakeHead = parts[i].first;
+        else
+            tail->next = parts[i].first;
+        tail = parts[i].last;
+    }
+    tail->next = NULL;
+    
+    list1.head = NULL;
+    list2.head = NULL;
+    list1.count = list2.count = 0;
+    list1.fingerprint = list2.fingerprint = 0;
+    makeEmpty();
+    head = fakeHead;
+    count = mergedCount;
+    fingerprint = mergedFingerprint;
+    if (this != &list1 && this != &list2)
+        notifyInserted(head, NULL, 0);
+    notifyGained(gained);
+}
+
+//----------------------------------------------------------------------------
+//parallelIntersect
+//gives the same list as intersect (copies of list1's items, params
+//unchanged), each partition copying its common items on its own thread
+template <typename T>
+void List<T>::parallelIntersect(List& list1, List& list2, int threads)
+{
+    threads = threadCount(threads);
+    if (threads < 2 || &list1 == &list2 || list1.isEmpty() ||
+        list2.isEmpty() || list1.count + list2.count < PARALLEL_MIN)
+    {
+        intersect(list1, list2);
+        return;
+    }
+    
+    vector<Partition> parts;
+    partition(list1, list2, threads, parts);
+    vector<thread> workers;
+    for (size_t i = 1; i < parts.size(); i++)
+        workers.push_back(thread(intersectPartition, &parts[i]));
+    intersectPartition(&parts[0]);
+    for (size_t i = 0; i < workers.size(); i++)
+        workers[i].join();
+    
+    Node* fakeHead = NULL;
+    Node* tail = NULL;
+    int commonCount = 0;
+    unsigned long commonFingerprint = 0;
+    for (size_t i = 0; i < parts.size(); i++)
+    {
+        commonCount += parts[i].count;
+        commonFingerprint += parts[i].fingerprint;
+        if (parts[i].first == NULL)
+            continue;
+        if (tail == NULL)
+            fakeHead = parts[i].first;
+        else
+            tail->next = parts[i].first;
+        tail = parts[i].last;
+    }
+    if (tail != NULL)
+        tail->next = NULL;
+    
+    //the object can be one of the params, only now are its nodes done with
+    makeEmpty();
+    head = fakeHead;
+    count = commonCount;
+    fingerprint = commonFingerprint;
+    notifyInserted(head, NULL, 0);
+}
+
+//----------------------------------------------------------------------------
+//threadCount
+//0 asks for one thread per core
+template <typename T>
+int List<T>::threadCount(int threads)
+{
+    if (threads <= 0)
+        threads = thread::hardware_concurrency();
+    return threads;
 }
+
+//----------------------------------------------------------------------------
+//sample
+//every stride-th node of a chain, starting with the first; the only part
+//of the split that walks whole lists, and it makes no comparisons
+template <typename T>
+void List<T>::sample(Node* chain, int length, int samples, vector<Node*>& out)
+{
+    int stride = length / samples > 0 ? length / samples : 1;
+    int i = 0;
+    for (Node* cur = chain; cur != NULL; cur = cur->next, i++)
+    {
+        if (i % stride == 0)
+            out.push_back(cur);
+    }
+}
+
+//----------------------------------------------------------------------------
+//lowerBound
+//first node whose item is not less than key: a binary search over the
+//samples of the chain, then a walk of at most one stride
+template <typename T>
+typename List<T>::Node* List<T>::lowerBound(const vector<Node*>& samples,
+                                            const T& key)
+{
+    //samples[lo] is the last sample less than key, if any
+    int lo = -1;
+    int hi = samples.size();
+    while (hi - lo > 1)
+    {
+        int mid = (lo + hi) / 2;
+        if (listCompare(samples[mid]->item(), key) < 0)
+            lo = mid;
+        else
+            hi = mid;
+    }
+    if (lo < 0)
+        return samples[0];
+    Node* cur = samples[lo];
+    while (cur != NULL && listCompare(cur->item(), key) < 0)
+        cur = cur->next;
+    return cur;
+}
+
+//----------------------------------------------------------------------------
+//partition
+//picks threads - 1 splitter keys evenly from the samples of both lists and
+//cuts each list at the first node not less than each splitter, so all the
+//items equal to a key land in the same partition in both lists
+template <typename T>
+void List<T>::partition(List& list1, List& list2, int threads,
+                        vector<Partition>& parts)
+{
+    vector<Node*> samples1;
+    vector<Node*> samples2;
+    sample(list1.head, list1.count, threads * 64, samples1);
+    sample(list2.head, list2.count, threads * 64, samples2);
+    
+    vector<Node*> all(samples1);
+    all.insert(all.end(), samples2.begin(), samples2.end());
+    sort(all.begin(), all.end(), NodeLess());
+    
+    Partition part;
+    part.start = list1.head;
+    part.start2 = list2.head;
+    part.first = part.last = NULL;
+    part.count = 0;
+    part.fingerprint = 0;
+    for (int i = 1; i < threads; i++)
+    {
+        const T& splitter = all[i * all.size() / threads]->item();
+        part.stop = lowerBound(samples1, splitter);
+        part.stop2 = lowerBound(samples2, splitter);
+        parts.push_back(part);
+        part.start = part.stop;
+        part.start2 = part.stop2;
+    }
+    part.stop = NULL;
+    part.stop2 = NULL;
+    parts.push_back(part);
+}
+
+//----------------------------------------------------------------------------
+//mergePartition
+//merge of one key range, the same steps as merge on a whole list
+template <typename T>
+void List<T>::mergePartition(Partition* part)
+{
+    Node* cur = part->start;
+    Node* cur2 = part->start2;
+    Node* tail = NULL;
+    while (cur != part->stop || cur2 != part->stop2)
+    {
+        Node* next;
+        if (cur2 == part->stop2 ||
+            (cur != part->stop &&
+             listCompare(cur->item(), cur2->item()) <= 0))
+        {
+            next = cur;
+            cur = cur->next;
+        }
+        else
+        {
+            next = cur2;
+            cur2 = cur2->next;
+        }
+        if (tail == NULL)
+            part->first = next;
+        else
+            tail->next = next;
+        tail = next;
+    }
+    part->last = tail;
+}
+
+//----------------------------------------------------------------------------
+//intersectPartition
+//intersect of one key range, copying list1's item for each match
+template <typename T>
+void List<T>::intersectPartition(Partition* part)
+{
+    Node* cur = part->start;
+    Node* cur2 = part->start2;
+    Node* tail = NULL;
+    while (cur != part->stop && cur2 != part->stop2)
+    {
+        int order = listCompare(cur->item(), cur2->item());
+        if (order == 0)
+        {
+            Node* copied = new Node;
+            copied->copyFrom(*cur);
+            copied->next = NULL;
+            part->count++;
+            part->fingerprint += mix(hashValue(copied->item()));
+            if (tail == NULL)
+                part->first = copied;
+            else
+                tail->next = copied;
+            tail = copied;
+            cur = cur->next;
+            cur2 = cur2->next;
+        }
+        else if (order < 0)
+            cur = cur->next;
+        else
+            cur2 = cur2->next;
+    }
+    part->last = tail;
+}
+
 //----------------------------------------------------------------------------
 //copy method
 //used in copy Constructor & operator=
 template <typename T>
 void List<T>::copy(const List& copy)
 {
+    head = NULL;
+    //same items as the copied list, so the same count and fingerprint.
+    count = copy.count;
+    fingerprint = copy.fingerprint;
+    
     //setting the head nodes first
     if (copy.head != NULL)
     {
         head = new Node;
-        head->data = new T;
-        *head->data = *copy.head->data;
+        head->copyFrom(*copy.head);
+        head->next = NULL;
     
         //cur pointing to head so we connect the next nodes using next.
         Node* cur = head;
@@ -542,13 +1455,156 @@ void List<T>::copy(const List& copy)
             //null, then going to the next of both.
             cur->next = new Node;
             cur = cur->next;
-            cur->data = new T;
-            *cur->data = *cur2->data;
+            cur->copyFrom(*cur2);
             cur->next = NULL;
             cur2 = cur2->next;
 
         }
     }
+    notifyInserted(head, NULL, 0);
+}
+
+//----------------------------------------------------------------------------
+//setIntersect
+//keeps the items found in both lists, the node from the 1st list is reused
+template <typename T>
+void List<T>::setIntersect(List& list1, List& list2)
+{
+    relink(list1, list2, false, true, false);
+}
+
+//----------------------------------------------------------------------------
+//setUnion
+//keeps every item found in either list, duplicates collapse to one node
+template <typename T>
+void List<T>::setUnion(List& list1, List& list2)
+{
+    relink(list1, list2, true, true, true);
+}
+
+//----------------------------------------------------------------------------
+//setDifference
+//keeps the items of the 1st list that are not in the 2nd list
+template <typename T>
+void List<T>::setDifference(List& list1, List& list2)
+{
+    relink(list1, list2, true, false, false);
+}
+
+//----------------------------------------------------------------------------
+//setSymmetricDifference
+//keeps the items found in exactly one of the lists
+template <typename T>
+void List<T>::setSymmetricDifference(List& list1, List& list2)
+{
+    relink(list1, list2, true, false, true);
+}
+
+//----------------------------------------------------------------------------
+//relink
+//one merge style pass over both sorted chains shared by the set operations.
+//Each distinct item is looked at once with all its duplicates in both lists;
+//the flags say whether it is kept when it is only in the 1st list, in both,
+//or only in the 2nd. A kept item reuses its first node (1st list first), all
+//other nodes go on a discard chain that is freed after the pass, so nothing
+//is allocated and every node is visited once.
+template <typename T>
+void List<T>::relink(List& list1, List& list2,
+                     bool keepOnly1, bool keepBoth, bool keepOnly2)
+{
+    //when both params are the same list, every item is in both lists.
+    bool same = (&list1 == &list2);
+    Node* cur = list1.head;
+    Node* cur2 = (same ? NULL : list2.head);
+    
+    //taking the chains away from the params, so when the object is one of
+    //them makeEmpty has nothing left to delete.
+    list1.notifyCleared();
+    if (!same)
+        list2.notifyCleared();
+    list1.head = list2.head = NULL;
+    list1.count = list2.count = 0;
+    list1.fingerprint = list2.fingerprint = 0;
+    makeEmpty();
+    
+    Node* tail = NULL;           //last kept node
+    Node* discard = NULL;        //nodes to free after the pass
+    
+    while (cur != NULL || cur2 != NULL)
+    {
+        //the first node holding the smallest item, and which lists have it
+        Node* first;
+        bool in1 = false;
+        bool in2 = false;
+        int order = (cur2 == NULL ? -1 :
+                     cur == NULL ? 1 : listCompare(cur->item(), cur2->item()));
+        if (order <= 0)
+        {
+            first = cur;
+            in1 = true;
+            in2 = same || order == 0;
+        }
+        else
+        {
+            first = cur2;
+            in2 = true;
+        }
+        
+        //taking every node equal to the item off both chains, keeping the
+        //first one only when the operation wants it.
+        bool keep = (in1 && in2 ? keepBoth : (in1 ? keepOnly1 : keepOnly2));
+        T* item = &first->item();
+        while (cur != NULL && listCompare(cur->item(), *item) == 0)
+        {
+            Node* temp = cur;
+            cur = cur->next;
+            if (temp != first || !keep)
+            {
+                temp->next = discard;
+                discard = temp;
+            }
+        }
+        while (cur2 != NULL && listCompare(cur2->item(), *item) == 0)
+        {
+            Node* temp = cur2;
+            cur2 = cur2->next;
+            if (temp != first || !keep)
+            {
+                temp->next = discard;
+                discard = temp;
+            }
+        }
+        
+        if (keep)
+        {
+            if (tail == NULL)
+                head = first;
+            else
+                tail->next = first;
+            tail = first;
+            count++;
+            fingerprint += mix(hashValue(first->item()));
+        }
+    }
+    
+    if (tail != NULL)
+        tail->next = NULL;
+    freeChain(discard);
+    notifyInserted(head, NULL, 0);
+}
+
+//----------------------------------------------------------------------------
+//freeChain
+//deletes every node of a NULL terminated chain and the data it points to
+template <typename T>
+void List<T>::freeChain(Node* chain)
+{
+    while (chain != NULL)
+    {
+        Node* temp = chain;
+        chain = chain->next;
+        Node::destroy(temp);
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -557,16 +1613,111 @@ void List<T>::copy(const List& copy)
 template <typename T>
 void List<T>::makeEmpty()
 {
+    if (head != NULL)
+        notifyCleared();
+    
     while (head != NULL)
     {
         Node* temp = head;
         head = head->next;
-    
-        if (temp->data != NULL)
-            delete temp->data;
-        
-        delete temp;
+        Node::destroy(temp);
         temp = NULL;
     }
+    count = 0;
+    fingerprint = 0;
+}
+
+//----------------------------------------------------------------------------
+//addObserver
+//the observer is told about every change from now on; items already in the
+//list are not reported, the observer loads those itself
+template <typename T>
+void List<T>::addObserver(ListObserver<T>* observer)
+{
+    observers.push_back(observer);
+}
+
+//----------------------------------------------------------------------------
+//removeObserver
+template <typename T>
+void List<T>::removeObserver(ListObserver<T>* observer)
+{
+    for (size_t i = 0; i < observers.size(); i++)
+    {
+        if (observers[i] == observer)
+        {
+            observers.erase(observers.begin() + i);
+            return;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+//notifyInserted
+//reports every node from first up to (not including) stop as inserted.
+//first has equalAhead equal items ahead of it, the count for the nodes
+//after it is carried on from there.
+template <typename T>
+void List<T>::notifyInserted(Node* first, Node* stop, int equalAhead) const
+{
+    if (observers.empty())
+        return;
+    Node* prev = NULL;
+    for (Node* cur = first; cur != stop; cur = cur->next)
+    {
+        if (prev != NULL)
+            equalAhead = (listCompare(prev->item(), cur->item()) == 0
+                          ? equalAhead + 1 : 0);
+        for (size_t i = 0; i < observers.size(); i++)
+            observers[i]->inserted(cur->item(), equalAhead);
+        prev = cur;
+    }
+}
+
+//----------------------------------------------------------------------------
+//notifyGained
+//reports the nodes a merge moved in from the other param, which keep their
+//order in the result: one walk of the list counts the equal items ahead of
+//each, those reported before it included
+template <typename T>
+void List<T>::notifyGained(const vector<Node*>& gained) const
+{
+    if (gained.empty())
+        return;
+    size_t next = 0;
+    int ahead = 0;
+    Node* prev = NULL;
+    for (Node* cur = head; cur != NULL && next < gained.size();
+         cur = cur->next)
+    {
+        if (prev != NULL)
+            ahead = (listCompare(prev->item(), cur->item()) == 0
+                     ? ahead + 1 : 0);
+        if (cur == gained[next])
+        {
+            notifyInserted(cur, cur->next, ahead);
+            next++;
+        }
+        prev = cur;
+    }
+}
+
+//----------------------------------------------------------------------------
+//notifyRemoved
+template <typename T>
+void List<T>::notifyRemoved(Node* node) const
+{
+    for (size_t i = 0; i < observers.size(); i++)
+        observers[i]->removed(node->item());
 }
+
+//----------------------------------------------------------------------------
+//notifyCleared
+template <typename T>
+void List<T>::notifyCleared() const
+{
+    for (size_t i = 0; i < observers.size(); i++)
+        observers[i]->cleared();
+}
+
 #endif
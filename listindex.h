@@ -0,0 +1,529 @@
+/////////////////////////////  listindex.h  //////////////////////////////////
+// Extra orderings over the items of a List<T>
+
+#ifndef LISTINDEX_H
+#define LISTINDEX_H
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <set>
+#include <vector>
+#include "list.h"
+using namespace std;
+
+//-------------------------  class SecondaryIndex  ---------------------------
+// Ordered index over a List<T> keyed by a projection of T (for Employee:
+// EmployeeSalary or EmployeeId), so items can be found by something other
+// than the order the list is sorted in.
+//
+// Assumptions:
+//   -- Key has operator<, Projection is a function object taking const T&.
+//   -- The index holds pointers to the items in the list, never copies. It
+//      registers itself as a ListObserver and so stays in step with insert,
+//      remove, merge, intersect, the set operations, operator= and
+//      makeEmpty of that list.
+//   -- The projected field must not change while the item is in the list.
+//----------------------------------------------------------------------------
+
+template <typename T, typename Key, typename Projection>
+class SecondaryIndex : public ListObserver<T> {
+public:
+   SecondaryIndex(List<T>&, Projection = Projection());  // index a list
+   ~SecondaryIndex();
+
+   int size() const;                        // number of items indexed
+
+   // items with lo <= key <= hi in key order (equal keys in no set
+   // order), O(log n + k); returns k
+   int rangeQuery(const Key& lo, const Key& hi, vector<const T*>&) const;
+
+   // ListObserver
+   void inserted(const T&, int);
+   void removed(const T&);
+   void cleared();
+   void detached();
+
+private:
+   typedef multimap<Key, const T*> Map;
+
+   List<T>* list;                           // NULL once the list is gone
+   Projection project;                      // item to key
+   Map entries;                             // key -> item in the list
+
+   SecondaryIndex(const SecondaryIndex&);             // not copyable
+   SecondaryIndex& operator=(const SecondaryIndex&);
+};
+
+//----------------------------------------------------------------------------
+// Constructor
+// indexes the items already in the list and follows it from then on
+template <typename T, typename Key, typename Projection>
+SecondaryIndex<T, Key, Projection>::SecondaryIndex(List<T>& theList,
+                                                   Projection projection)
+   : list(&theList), project(projection)
+{
+    for (typename List<T>::const_iterator it = theList.begin();
+         it != theList.end(); ++it)
+        inserted(*it, 0);
+    theList.addObserver(this);
+}
+
+//----------------------------------------------------------------------------
+// Destructor
+template <typename T, typename Key, typename Projection>
+SecondaryIndex<T, Key, Projection>::~SecondaryIndex()
+{
+    if (list != NULL)
+        list->removeObserver(this);
+}
+
+//----------------------------------------------------------------------------
+// size
+template <typename T, typename Key, typename Projection>
+int SecondaryIndex<T, Key, Projection>::size() const
+{
+    return entries.size();
+}
+
+//----------------------------------------------------------------------------
+// rangeQuery
+// fills found with the items whose key is in [lo, hi], in key order
+template <typename T, typename Key, typename Projection>
+int SecondaryIndex<T, Key, Projection>::rangeQuery(const Key& lo,
+        const Key& hi, vector<const T*>& found) const
+{
+    found.clear();
+    typename Map::const_iterator last = entries.upper_bound(hi);
+    for (typename Map::const_iterator it = entries.lower_bound(lo);
+         it != last; ++it)
+        found.push_back(it->second);
+    return found.size();
+}
+
+//----------------------------------------------------------------------------
+// inserted
+template <typename T, typename Key, typename Projection>
+void SecondaryIndex<T, Key, Projection>::inserted(const T& item, int)
+{
+    entries.insert(typename Map::value_type(project(item), &item));
+}
+
+//----------------------------------------------------------------------------
+// removed
+// only the entry for this very item goes, not others with the same key
+template <typename T, typename Key, typename Projection>
+void SecondaryIndex<T, Key, Projection>::removed(const T& item)
+{
+    pair<typename Map::iterator, typename Map::iterator> range =
+        entries.equal_range(project(item));
+    for (typename Map::iterator it = range.first; it != range.second; ++it)
+    {
+        if (it->second == &item)
+        {
+            entries.erase(it);
+            return;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+// cleared
+template <typename T, typename Key, typename Projection>
+void SecondaryIndex<T, Key, Projection>::cleared()
+{
+    entries.clear();
+}
+
+//----------------------------------------------------------------------------
+// detached
+template <typename T, typename Key, typename Projection>
+void SecondaryIndex<T, Key, Projection>::detached()
+{
+    entries.clear();
+    list = NULL;
+}
+
+//----------------------------  ListIdentity  --------------------------------
+// projection that keys an index by the item itself, in the list's own order
+struct ListIdentity {
+   template <typename T>
+   const T& operator()(const T& item) const { return item; }
+};
+
+//----------------------  class OrderStatisticIndex  -------------------------
+// Rank and select over a List<T> in O(log n): "how many employees sort
+// before X", "the k-th employee alphabetically" (ListIdentity) or salary
+// percentiles (EmployeeSalary). The items are kept in a treap (a randomly
+// balanced binary search tree) whose nodes know the size of their subtree.
+//
+// Assumptions:
+//   -- Same as SecondaryIndex: pointers to the list's items, kept in step
+//      through ListObserver, projected field must not change.
+//   -- Items with equal keys are kept in list order: select(k) with
+//      ListIdentity is the list's k-th item, with a projection the k-th of
+//      the list stably sorted by key. For that the index also keeps every
+//      run of items the list holds as equal in list order, so inserted and
+//      removed cost O(log n + e) for e items equal to the one they report.
+//----------------------------------------------------------------------------
+
+template <typename T, typename Key = T, typename Projection = ListIdentity>
+class OrderStatisticIndex : public ListObserver<T> {
+public:
+   OrderStatisticIndex(List<T>&, Projection = Projection());
+   ~OrderStatisticIndex();
+
+   int size() const;
+   int rank(const Key&) const;              // items with key < the given key
+   const T* select(int k) const;            // k-th item by key, from 0;
+                                            // NULL if k is out of range
+   const T* percentile(double p) const;     // nearest rank, 0 < p <= 100
+
+   // ListObserver
+   void inserted(const T&, int);
+   void removed(const T&);
+   void cleared();
+   void detached();
+
+private:
+   struct TreeNode {
+      const T* item;                        // item in the list
+      unsigned int priority;                // heap order, random
+      int size;                             // nodes in this subtree
+      TreeNode* left;
+      TreeNode* right;
+   };
+
+   // items the list holds as equal, in list order; key is any one of
+   // them. The members are mutable because changing them never changes the
+   // run's order.
+   struct Run {
+      mutable const T* key;
+      mutable vector<const T*> items;
+   };
+
+   struct RunLess {
+      bool operator()(const Run& a, const Run& b) const
+         { return listCompare(*a.key, *b.key) < 0; }
+   };
+
+   typedef set<Run, RunLess> Runs;
+
+   List<T>* list;                           // NULL once the list is gone
+   Projection project;                      // item to key
+   TreeNode* root;
+   unsigned int seed;                       // for priorities
+   Runs runs;                               // equal items in list order
+
+   int countBefore(const T*) const;         // nodes ordered before an item
+   int sameKey(const vector<const T*>&, size_t, const T&) const;
+   static int sizeOf(TreeNode*);
+   static void update(TreeNode*);
+   static void split(TreeNode*, int, TreeNode*&, TreeNode*&);
+   TreeNode* join(TreeNode*, TreeNode*);
+   static void destroy(TreeNode*);
+
+   OrderStatisticIndex(const OrderStatisticIndex&);   // not copyable
+   OrderStatisticIndex& operator=(const OrderStatisticIndex&);
+};
+
+//----------------------------------------------------------------------------
+// Constructor
+// indexes the items already in the list and follows it from then on
+template <typename T, typename Key, typename Projection>
+OrderStatisticIndex<T, Key, Projection>::OrderStatisticIndex(
+        List<T>& theList, Projection projection)
+   : list(&theList), project(projection), root(NULL), seed(2463534242u)
+{
+    //in list order, so each equal item goes behind the ones before it
+    for (typename List<T>::const_iterator it = theList.begin();
+         it != theList.end(); ++it)
+        inserted(*it, theList.size());
+    theList.addObserver(this);
+}
+
+//----------------------------------------------------------------------------
+// Destructor
+template <typename T, typename Key, typename Projection>
+OrderStatisticIndex<T, Key, Projection>::~OrderStatisticIndex()
+{
+    if (list != NULL)
+        list->removeObserver(this);
+    destroy(root);
+}
+
+//----------------------------------------------------------------------------
+// size
+template <typename T, typename Key, typename Projection>
+int OrderStatisticIndex<T, Key, Projection>::size() const
+{
+    return sizeOf(root);
+}
+
+//----------------------------------------------------------------------------
+// rank
+// one walk down the tree, counting everything passed on the left
+template <typename T, typename Key, typename Projection>
+int OrderStatisticIndex<T, Key, Projection>::rank(const Key& key) const
+{
+    int less = 0;
+    TreeNode* cur = root;
+    while (cur != NULL)
+    {
+        if (listCompare(project(*cur->item), key) < 0)
+        {
+            less += sizeOf(cur->left) + 1;
+            cur = cur->right;
+        }
+        else
+            cur = cur->left;
+    }
+    return less;
+}
+
+//----------------------------------------------------------------------------
+// select
+template <typename T, typename Key, typename Projection>
+const T* OrderStatisticIndex<T, Key, Projection>::select(int k) const
+{
+    if (k < 0 || k >= size())
+        return NULL;
+    TreeNode* cur = root;
+    for (;;)
+    {
+        int leftSize = sizeOf(cur->left);
+        if (k < leftSize)
+            cur = cur->left;
+        else if (k == leftSize)
+            return cur->item;
+        else
+        {
+            k -= leftSize + 1;
+            cur = cur->right;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+// percentile
+// the smallest item with at least p percent of the items at or below it.
+// p / 100 is rarely exact (7 / 100 * 100 comes to 7.000000000000001, which
+// would pick the 8th of 100), so the product is taken first and a relative
+// slack far below one rank absorbs the rounding left in it.
+template <typename T, typename Key, typename Projection>
+const T* OrderStatisticIndex<T, Key, Projection>::percentile(double p) const
+{
+    int n = size();
+    if (n == 0 || p <= 0 || p > 100)
+        return NULL;
+    double rank = p * n / 100;
+    int k = (int)ceil(rank - rank * 1e-12);
+    if (k < 1)
+        k = 1;
+    if (k > n)
+        k = n;
+    return select(k - 1);
+}
+
+//----------------------------------------------------------------------------
+// inserted
+// the new item goes behind equalAhead of the items equal to it (all of them
+// when there are fewer); in the tree that is behind those of them with its
+// key. Splits the tree there and joins the three parts.
+template <typename T, typename Key, typename Projection>
+void OrderStatisticIndex<T, Key, Projection>::inserted(const T& item,
+                                                       int equalAhead)
+{
+    TreeNode* node = new TreeNode;
+    node->item = &item;
+    seed ^= seed << 13;                     // xorshift
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    node->priority = seed;
+    node->size = 1;
+    node->left = node->right = NULL;
+
+    Run probe;
+    probe.key = &item;
+    vector<const T*>& items = runs.insert(probe).first->items;
+    size_t at = min((size_t)equalAhead, items.size());
+    int ahead = sameKey(items, at, item);
+    items.insert(items.begin() + at, &item);
+
+    TreeNode* left;
+    TreeNode* right;
+    split(root, countBefore(&item) + ahead, left, right);
+    root = join(join(left, node), right);
+}
+
+//----------------------------------------------------------------------------
+// removed
+// only that very item goes: its place among the items equal to it gives
+// its place in the tree, where it is split out before the rest is joined
+template <typename T, typename Key, typename Projection>
+void OrderStatisticIndex<T, Key, Projection>::removed(const T& item)
+{
+    Run probe;
+    probe.key = &item;
+    typename Runs::iterator run = runs.find(probe);
+    if (run == runs.end())
+        return;
+    vector<const T*>& items = run->items;
+    typename vector<const T*>::iterator found =
+        find(items.begin(), items.end(), &item);
+    if (found == items.end())
+        return;
+    int at = countBefore(&item) + sameKey(items, found - items.begin(), item);
+    items.erase(found);
+    if (items.empty())
+        runs.erase(run);
+    else if (run->key == &item)
+        run->key = items[0];
+
+    TreeNode* left;
+    TreeNode* rest;
+    TreeNode* gone;
+    TreeNode* right;
+    split(root, at, left, rest);
+    split(rest, 1, gone, right);
+    root = join(left, right);
+    delete gone;
+}
+
+//----------------------------------------------------------------------------
+// cleared
+template <typename T, typename Key, typename Projection>
+void OrderStatisticIndex<T, Key, Projection>::cleared()
+{
+    destroy(root);
+    root = NULL;
+    runs.clear();
+}
+
+//----------------------------------------------------------------------------
+// detached
+template <typename T, typename Key, typename Projection>
+void OrderStatisticIndex<T, Key, Projection>::detached()
+{
+    cleared();
+    list = NULL;
+}
+
+//----------------------------------------------------------------------------
+// countBefore
+// nodes whose key, or else whose item in the list's own order, is less than
+// item's, in one walk down the tree
+template <typename T, typename Key, typename Projection>
+int OrderStatisticIndex<T, Key, Projection>::countBefore(const T* item) const
+{
+    int count = 0;
+    TreeNode* cur = root;
+    while (cur != NULL)
+    {
+        int order = listCompare(project(*cur->item), project(*item));
+        if (order == 0)
+            order = listCompare(*cur->item, *item);
+        if (order < 0)
+        {
+            count += sizeOf(cur->left) + 1;
+            cur = cur->right;
+        }
+        else
+            cur = cur->left;
+    }
+    return count;
+}
+
+//----------------------------------------------------------------------------
+// sameKey
+// how many of the first end items of a run have item's key
+template <typename T, typename Key, typename Projection>
+int OrderStatisticIndex<T, Key, Projection>::sameKey(
+        const vector<const T*>& items, size_t end, const T& item) const
+{
+    int count = 0;
+    for (size_t i = 0; i < end; i++)
+    {
+        if (listCompare(project(*items[i]), project(item)) == 0)
+            count++;
+    }
+    return count;
+}
+
+//----------------------------------------------------------------------------
+// sizeOf
+template <typename T, typename Key, typename Projection>
+int OrderStatisticIndex<T, Key, Projection>::sizeOf(TreeNode* node)
+{
+    return node == NULL ? 0 : node->size;
+}
+
+//----------------------------------------------------------------------------
+// update
+template <typename T, typename Key, typename Projection>
+void OrderStatisticIndex<T, Key, Projection>::update(TreeNode* node)
+{
+    node->size = sizeOf(node->left) + 1 + sizeOf(node->right);
+}
+
+//----------------------------------------------------------------------------
+// split
+// left gets the first count nodes in order, right the rest
+template <typename T, typename Key, typename Projection>
+void OrderStatisticIndex<T, Key, Projection>::split(TreeNode* node,
+        int count, TreeNode*& left, TreeNode*& right)
+{
+    if (node == NULL)
+    {
+        left = right = NULL;
+        return;
+    }
+    int leftSize = sizeOf(node->left);
+    if (leftSize < count)
+    {
+        split(node->right, count - leftSize - 1, node->right, right);
+        left = node;
+    }
+    else
+    {
+        split(node->left, count, left, node->left);
+        right = node;
+    }
+    update(node);
+}
+
+//----------------------------------------------------------------------------
+// join
+// every node of left is ordered before every node of right
+template <typename T, typename Key, typename Projection>
+typename OrderStatisticIndex<T, Key, Projection>::TreeNode*
+OrderStatisticIndex<T, Key, Projection>::join(TreeNode* left, TreeNode* right)
+{
+    if (left == NULL)
+        return right;
+    if (right == NULL)
+        return left;
+    if (left->priority > right->priority)
+    {
+        left->right = join(left->right, right);
+        update(left);
+        return left;
+    }
+    right->left = join(left, right->left);
+    update(right);
+    return right;
+}
+
+//----------------------------------------------------------------------------
+// destroy
+template <typename T, typename Key, typename Projection>
+void OrderStatisticIndex<T, Key, Projection>::destroy(TreeNode* node)
+{
+    if (node == NULL)
+        return;
+    destroy(node->left);
+    destroy(node->right);
+    delete node;
+}
+
+#endif
@@ -0,0 +1,598 @@
+////////////////////////////  listjournal.h  /////////////////////////////////
+// Append only change journal for a List<T>, for fast restarts
+
+#ifndef LISTJOURNAL_H
+#define LISTJOURNAL_H
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <fcntl.h>
+#include <unistd.h>
+#include "list.h"
+using namespace std;
+
+//----------------------------------------------------------------------------
+// serialize / deserialize
+// binary form of an item in the journal. Trivially copyable types (NodeData)
+// are stored as their bytes; other types (Employee) provide their own
+// overloads, found through ADL like hashValue.
+template <typename T>
+typename enable_if<is_trivially_copyable<T>::value>::type
+serialize(string& out, const T& item) {
+   out.append(reinterpret_cast<const char*>(&item), sizeof(T));
+}
+
+template <typename T>
+typename enable_if<is_trivially_copyable<T>::value, bool>::type
+deserialize(const char*& in, const char* end, T& item) {
+   if (end - in < (long)sizeof(T)) return false;
+   memcpy(static_cast<void*>(&item), in, sizeof(T));
+   in += sizeof(T);
+   return true;
+}
+
+//---------------------------  class ListJournal  ----------------------------
+// Write ahead journal attached to a List<T> as a ListObserver. Every insert,
+// remove and makeEmpty on the list (merge, intersect and the set operations
+// show up as the clears and inserts they cause) appends a small binary
+// record to a buffer. Replay rebuilds the list exactly, including the order
+// of equal items (Employees with the same name): an insert records how many
+// equal items were ahead of it, and a remove takes out the equal item whose
+// record matches byte for byte. Records go to disk in groups: one write and
+// one fsync per groupSize records, or whenever commit is called.
+//
+// A group that cannot be written and synced is cut off the segment again
+// and kept in the buffer, and the journal turns failed(): it records
+// nothing more and commit returns false, so the files still replay to the
+// list as of the last good commit. compact() is the way back, it writes a
+// base from the list itself (on the caller's thread when failed) and starts
+// over with an empty buffer and a new segment.
+//
+// Files, for a journal at path:
+//   path.base    sorted image of the list, holding every change up to the
+//                generation stored in its header
+//   path.N.log   journal segment N, replayed in order when N is past the
+//                base's generation
+//
+// compact() starts a new segment and writes a fresh base from a snapshot of
+// the list on a background thread, then deletes the segments it folded in,
+// so a restart reads one base and only the changes made since.
+//
+// Restart:
+//   List<Employee> list;
+//   list.buildList(infile);                 // only needed with no base yet
+//   ListJournal<Employee>::recover(list, path);
+//   ListJournal<Employee> journal(list, path);
+//
+// Assumptions:
+//   -- recover runs before the journal is attached, so replayed changes
+//      are not journaled a second time. When a base exists it replaces
+//      whatever the list held.
+//   -- Records are in native byte order, the files are not portable
+//      between machines with different endianness.
+//   -- Records after the last commit can be lost in a crash; a torn record
+//      at the end of a segment is detected by its checksum and ignored.
+//----------------------------------------------------------------------------
+
+template <typename T>
+class ListJournal : public ListObserver<T> {
+public:
+   ListJournal(List<T>&, const string& path, int groupSize = 64);
+   ~ListJournal();
+
+   static bool recover(List<T>&, const string& path);  // base + replay
+
+   bool isOpen() const;                     // segment file could be opened
+   bool failed() const;                     // changes are not all on disk
+   bool commit();                           // write and fsync the buffer
+   bool compact();                          // start folding into a new base
+   void waitForCompaction();                // until the base is written
+
+   // ListObserver
+   void inserted(const T&, int equalAhead);
+   void removed(const T&);
+   void cleared();
+   void detached();
+
+private:
+   enum { INSERT = 1, REMOVE = 2, CLEAR = 3,   // record types in segments
+          ITEM = 4 };                           // and in the base
+
+   List<T>* list;                           // NULL once the list is gone
+   string path;                             // prefix of every file name
+   int groupSize;                           // records per write and fsync
+   int pending;                             // records in buffer
+   string buffer;                           // records not yet written
+   int fd;                                  // current segment, -1 if none
+   bool failure;                            // a group could not be written
+   unsigned long generation;                // number of current segment
+   thread compactor;                        // background base writer
+
+   void append(char type, const T*, int ahead = 0);
+   bool openSegment();
+
+   static void appendRecord(string&, char type, const T*, int ahead);
+   static bool readRecord(const char*&, const char*, char& type, T&,
+                          int& ahead);
+   static void replayRemove(List<T>&, const T&);
+   static unsigned int checksum(const char*, size_t);
+   static string segmentName(const string&, unsigned long);
+   static string baseName(const string&);
+   static bool readFile(const string&, string&);
+   static bool writeAll(int fd, const string&);
+   static unsigned long baseGeneration(const string&);
+   static bool loadBase(List<T>&, const string&);
+   static bool replaySegment(List<T>&, const string&);
+   static bool writeBase(string path, unsigned long generation, string image);
+
+   ListJournal(const ListJournal&);                   // not copyable
+   ListJournal& operator=(const ListJournal&);
+};
+
+//----------------------------------------------------------------------------
+// Constructor
+// attaches to the list and starts a new segment after every existing one
+template <typename T>
+ListJournal<T>::ListJournal(List<T>& theList, const string& thePath,
+                            int group)
+   : list(&theList), path(thePath),
+     groupSize(group > 0 ? group : 1), pending(0), fd(-1), failure(false),
+     generation(0)
+{
+    generation = baseGeneration(path);
+    while (access(segmentName(path, generation + 1).c_str(), F_OK) == 0)
+        generation++;
+    generation++;
+    failure = !openSegment();
+    theList.addObserver(this);
+}
+
+//----------------------------------------------------------------------------
+// Destructor
+// everything buffered is committed before the journal goes away
+template <typename T>
+ListJournal<T>::~ListJournal()
+{
+    if (list != NULL)
+        list->removeObserver(this);
+    commit();
+    waitForCompaction();
+    if (fd >= 0)
+        close(fd);
+}
+
+//----------------------------------------------------------------------------
+// recover
+// loads path.base into the list if there is one, then replays every later
+// segment in order; returns false if a file could not be read
+template <typename T>
+bool ListJournal<T>::recover(List<T>& theList, const string& thePath)
+{
+    if (access(baseName(thePath).c_str(), F_OK) == 0 &&
+        !loadBase(theList, baseName(thePath)))
+        return false;
+
+    for (unsigned long gen = baseGeneration(thePath) + 1;
+         access(segmentName(thePath, gen).c_str(), F_OK) == 0; gen++)
+    {
+        if (!replaySegment(theList, segmentName(thePath, gen)))
+            return false;
+    }
+    return true;
+}
+
+//----------------------------------------------------------------------------
+// isOpen
+template <typename T>
+bool ListJournal<T>::isOpen() const
+{
+    return fd >= 0;
+}
+
+//----------------------------------------------------------------------------
+// failed
+template <typename T>
+bool ListJournal<T>::failed() const
+{
+    return failure;
+}
+
+//----------------------------------------------------------------------------
+// commit
+// group commit: every buffered record in one write, then one fsync. If
+// either fails the segment is truncated back to where the group started,
+// the group stays buffered and the journal is failed from then on.
+template <typename T>
+bool ListJournal<T>::commit()
+{
+    if (failure)
+        return false;
+    if (pending == 0)
+        return true;
+
+    off_t start = lseek(fd, 0, SEEK_END);
+    if (start < 0 || !writeAll(fd, buffer) || fsync(fd) != 0)
+    {
+        if (start >= 0 && ftruncate(fd, start) == 0)
+            fsync(fd);
+        failure = true;
+        return false;
+    }
+    buffer.clear();
+    pending = 0;
+    return true;
+}
+
+//----------------------------------------------------------------------------
+// compact
+// closes the current segment, starts the next one and writes the base from
+// a snapshot of the list on a background thread. Only the snapshot (an
+// in memory copy of the records) is taken on the caller's thread. When the
+// journal has failed the base is written right away instead, since only
+// the base holds the changes that never reached a segment; once it is
+// durable the unwritten records are dropped and the journal records again.
+template <typename T>
+bool ListJournal<T>::compact()
+{
+    if (list == NULL)
+        return false;
+    waitForCompaction();
+    if (!failure && !commit())
+        return false;
+
+    string image("LJB1");
+    unsigned long folded = generation;
+    image.append(reinterpret_cast<const char*>(&folded), sizeof(folded));
+    for (typename List<T>::const_iterator it = list->begin();
+         it != list->end(); ++it)
+        appendRecord(image, ITEM, &*it, 0);
+
+    if (fd >= 0)
+        close(fd);
+    generation++;
+    if (!openSegment())
+    {
+        failure = true;
+        return false;
+    }
+
+    if (failure)
+    {
+        if (!writeBase(path, folded, image))
+            return false;
+        buffer.clear();
+        pending = 0;
+        failure = false;
+        return true;
+    }
+    compactor = thread(writeBase, path, folded, image);
+    return true;
+}
+
+//----------------------------------------------------------------------------
+// waitForCompaction
+template <typename T>
+void ListJournal<T>::waitForCompaction()
+{
+    if (compactor.joinable())
+        compactor.join();
+}
+
+//----------------------------------------------------------------------------
+// inserted
+template <typename T>
+void ListJournal<T>::inserted(const T& item, int equalAhead)
+{
+    append(INSERT, &item, equalAhead);
+}
+
+//----------------------------------------------------------------------------
+// removed
+template <typename T>
+void ListJournal<T>::removed(const T& item)
+{
+    append(REMOVE, &item);
+}
+
+//----------------------------------------------------------------------------
+// cleared
+template <typename T>
+void ListJournal<T>::cleared()
+{
+    append(CLEAR, NULL);
+}
+
+//----------------------------------------------------------------------------
+// detached
+// the list is gone, what it did so far still reaches the disk
+template <typename T>
+void ListJournal<T>::detached()
+{
+    commit();
+    list = NULL;
+}
+
+//----------------------------------------------------------------------------
+// append
+// buffers one record, writing the group out once it is full. Nothing is
+// buffered once the journal has failed, the buffer would only grow.
+template <typename T>
+void ListJournal<T>::append(char type, const T* item, int ahead)
+{
+    if (failure)
+        return;
+    appendRecord(buffer, type, item, ahead);
+    pending++;
+    if (pending >= groupSize)
+        commit();
+}
+
+//----------------------------------------------------------------------------
+// openSegment
+template <typename T>
+bool ListJournal<T>::openSegment()
+{
+    fd = open(segmentName(path, generation).c_str(),
+              O_WRONLY | O_CREAT | O_APPEND, 0644);
+    return fd >= 0;
+}
+
+//----------------------------------------------------------------------------
+// appendRecord
+// record layout: type (1 byte), payload length (4), payload, checksum of
+// type and payload (4). The payload is the item, after the number of
+// equal items ahead of it (4) for an INSERT.
+template <typename T>
+void ListJournal<T>::appendRecord(string& out, char type, const T* item,
+                                  int ahead)
+{
+    size_t start = out.size();
+    out += type;
+    out.append(4, '\0');
+    if (type == INSERT)
+        out.append(reinterpret_cast<const char*>(&ahead), 4);
+    if (item != NULL)
+        serialize(out, *item);
+
+    unsigned int length = out.size() - start - 5;
+    memcpy(&out[start + 1], &length, 4);
+    unsigned int sum = checksum(out.data() + start, out.size() - start);
+    out.append(reinterpret_cast<const char*>(&sum), 4);
+}
+
+//----------------------------------------------------------------------------
+// readRecord
+// false at the end of the data or at a torn or damaged record
+template <typename T>
+bool ListJournal<T>::readRecord(const char*& in, const char* end,
+                                char& type, T& item, int& ahead)
+{
+    unsigned int length;
+    unsigned int sum;
+    if (end - in < 9)
+        return false;
+    memcpy(&length, in + 1, 4);
+    if ((unsigned long)(end - in - 9) < length)
+        return false;
+    memcpy(&sum, in + 5 + length, 4);
+    if (sum != checksum(in, 5 + length))
+        return false;
+
+    type = in[0];
+    const char* payload = in + 5;
+    ahead = 0;
+    if (type == INSERT)
+    {
+        if (length < 4)
+            return false;
+        memcpy(&ahead, payload, 4);
+        payload += 4;
+    }
+    if (payload != in + 5 + length &&
+        (!deserialize(payload, in + 5 + length, item) ||
+         payload != in + 5 + length))
+        return false;
+    in += 9 + length;
+    return true;
+}
+
+//----------------------------------------------------------------------------
+// checksum
+// FNV-1a, enough to notice a record cut short by a crash
+template <typename T>
+unsigned int ListJournal<T>::checksum(const char* data, size_t length)
+{
+    unsigned int hash = 2166136261u;
+    for (size_t i = 0; i < length; i++)
+    {
+        hash ^= (unsigned char)data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+//----------------------------------------------------------------------------
+// segmentName
+template <typename T>
+string ListJournal<T>::segmentName(const string& prefix, unsigned long gen)
+{
+    ostringstream name;
+    name << prefix << "." << gen << ".log";
+    return name.str();
+}
+
+//----------------------------------------------------------------------------
+// baseName
+template <typename T>
+string ListJournal<T>::baseName(const string& prefix)
+{
+    return prefix + ".base";
+}
+
+//----------------------------------------------------------------------------
+// readFile
+template <typename T>
+bool ListJournal<T>::readFile(const string& name, string& contents)
+{
+    ifstream infile(name.c_str(), ios::in | ios::binary);
+    if (!infile)
+        return false;
+    ostringstream all;
+    all << infile.rdbuf();
+    contents = all.str();
+    return true;
+}
+
+//----------------------------------------------------------------------------
+// writeAll
+template <typename T>
+bool ListJournal<T>::writeAll(int file, const string& data)
+{
+    size_t done = 0;
+    while (done < data.size())
+    {
+        ssize_t written = write(file, data.data() + done, data.size() - done);
+        if (written < 0)
+            return false;
+        done += written;
+    }
+    return true;
+}
+
+//----------------------------------------------------------------------------
+// baseGeneration
+// last segment folded into path.base, 0 when there is no base
+template <typename T>
+unsigned long ListJournal<T>::baseGeneration(const string& prefix)
+{
+    unsigned long gen = 0;
+    char header[4];
+    ifstream infile(baseName(prefix).c_str(), ios::in | ios::binary);
+    if (infile.read(header, 4) && memcmp(header, "LJB1", 4) == 0)
+        infile.read(reinterpret_cast<char*>(&gen), sizeof(gen));
+    return infile ? gen : 0;
+}
+
+//----------------------------------------------------------------------------
+// loadBase
+// the base holds the items in list order, so they go back in as one run
+template <typename T>
+bool ListJournal<T>::loadBase(List<T>& theList, const string& name)
+{
+    string image;
+    if (!readFile(name, image) || image.size() < 12 ||
+        image.compare(0, 4, "LJB1") != 0)
+        return false;
+
+    vector<T*> items;
+    const char* in = image.data() + 12;
+    const char* end = image.data() + image.size();
+    char type;
+    T item;
+    int ahead;
+    while (readRecord(in, end, type, item, ahead))
+        items.push_back(new T(item));
+
+    theList.makeEmpty();
+    theList.appendRun(items);
+    return in == end;
+}
+
+//----------------------------------------------------------------------------
+// replaySegment
+// applies a segment's records; replay stops at a torn last record
+template <typename T>
+bool ListJournal<T>::replaySegment(List<T>& theList, const string& name)
+{
+    string log;
+    if (!readFile(name, log))
+        return false;
+
+    const char* in = log.data();
+    const char* end = log.data() + log.size();
+    char type;
+    T item;
+    int ahead;
+    while (readRecord(in, end, type, item, ahead))
+    {
+        if (type == INSERT)
+            theList.insert(new T(item), ahead);
+        else if (type == REMOVE)
+            replayRemove(theList, item);
+        else if (type == CLEAR)
+            theList.makeEmpty();
+    }
+    return true;
+}
+
+//----------------------------------------------------------------------------
+// replayRemove
+// of the items equal to item, removes the first one that serializes to the
+// same bytes, so with several Employees of one name it is the very one that
+// was removed (or one indistinguishable from it). Nothing is removed when
+// none matches.
+template <typename T>
+void ListJournal<T>::replayRemove(List<T>& theList, const T& item)
+{
+    string wanted;
+    serialize(wanted, item);
+    int skip = 0;
+    for (typename List<T>::const_iterator it = theList.lowerBound(item);
+         it != theList.end() && listCompare(*it, item) == 0; ++it, skip++)
+    {
+        string candidate;
+        serialize(candidate, *it);
+        if (candidate == wanted)
+        {
+            T* removed;
+            if (theList.remove(item, removed, skip))
+                delete removed;
+            return;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+// writeBase
+// runs on the compaction thread (the caller's when failed, see compact):
+// writes the image to a temporary file, makes it durable and renames it
+// over the old base, then deletes the segments it folded in. A crash at any
+// point leaves either the old base with all its segments or the new base;
+// leftover segments at or below the base's generation are skipped by
+// recover and deleted next time. Returns whether the new base is in place.
+template <typename T>
+bool ListJournal<T>::writeBase(string prefix, unsigned long gen, string image)
+{
+    string temp = baseName(prefix) + ".tmp";
+    int file = open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (file < 0)
+        return false;
+    bool success = writeAll(file, image) && fsync(file) == 0;
+    close(file);
+    if (!success || rename(temp.c_str(), baseName(prefix).c_str()) != 0)
+    {
+        unlink(temp.c_str());
+        return false;
+    }
+
+    //the rename must be durable before the segments go
+    string dir = prefix.find('/') == string::npos ? "." :
+                 prefix.substr(0, prefix.rfind('/') + 1);
+    int dirFile = open(dir.c_str(), O_RDONLY);
+    if (dirFile >= 0)
+    {
+        fsync(dirFile);
+        close(dirFile);
+    }
+    for (unsigned long g = gen; g > 0 && unlink(segmentName(prefix, g).c_str())
+         == 0; g--)
+        ;
+    return true;
+}
+
+#endif
@@ -0,0 +1,345 @@
+/////////////////////////////  listview.h  ///////////////////////////////////
+// Intersection or merge of two Lists, kept current as they change
+
+#ifndef LISTVIEW_H
+#define LISTVIEW_H
+
+#include <algorithm>
+#include <iostream>
+#include <set>
+#include <vector>
+#include "list.h"
+using namespace std;
+
+//----------------------------  class ListView  ------------------------------
+// The result List<T>::intersect or List<T>::merge would give for two source
+// lists, maintained as the sources change instead of recomputed. The view
+// observes both sources and files every item under its group of equal
+// items, so an insert or remove in either source costs O(log g + e) for g
+// groups and e items in the item's group (the source tells how many equal
+// items are ahead of an insert, the group is a vector shifted to make
+// room), and makeEmpty of a source costs one pass over the groups.
+//
+// Multiplicities and order follow the List operations: an item present a
+// times in the first source and b times in the second is in the
+// intersection min(a, b) times (the first of list1's copies) and in the
+// merge a + b times (list1's copies, then list2's), equal items in the
+// order their source lists hold them. The merge view counts a + b copies
+// even when the two sources hold equal contents, where List::merge keeps
+// only one copy of them. Walk the result with begin/end or operator<<, or
+// write it out as an ordinary List with exportTo.
+//
+// Assumptions:
+//   -- Like the indexes in listindex.h, the view holds pointers to the
+//      sources' items, never copies, and follows them through ListObserver.
+//   -- The two sources may be the same list.
+//   -- Items must not change their order while they are in a source.
+//----------------------------------------------------------------------------
+
+template <typename T>
+class ListView {
+   friend ostream& operator<<(ostream& output, const ListView<T>& view) {
+      for (const_iterator it = view.begin(); it != view.end(); ++it)
+         output << *it;
+      return output;
+   }
+
+   // equal items from both sources; key is any one of them. The members
+   // are mutable because changing them never changes the group's order.
+   struct Group {
+      mutable const T* key;
+      mutable vector<const T*> items[2];    // by source, in list order
+   };
+
+   struct GroupLess {
+      bool operator()(const Group& a, const Group& b) const
+         { return listCompare(*a.key, *b.key) < 0; }
+   };
+
+   typedef set<Group, GroupLess> Groups;
+
+public:
+   enum Operation { INTERSECT, MERGE };     // which List result to keep
+
+   ListView(List<T>&, List<T>&, Operation = INTERSECT);
+   ~ListView();
+
+   int size() const;                        // items in the result
+   bool contains(const T&) const;           // is an equal item in it
+   int count(const T&) const;               // how many equal items
+   void exportTo(List<T>&) const;           // insert copies into a List
+
+   // walks the result in order; invalid once a source changes
+   class const_iterator {
+   public:
+      const_iterator() : view(NULL), index(0) { }
+      const T& operator*() const { return *view->at(group, index); }
+      const T* operator->() const { return view->at(group, index); }
+      const_iterator& operator++();
+      bool operator==(const const_iterator& other) const
+         { return group == other.group && index == other.index; }
+      bool operator!=(const const_iterator& other) const
+         { return !(*this == other); }
+   private:
+      friend class ListView;
+      const ListView* view;
+      typename Groups::const_iterator group;
+      int index;                            // within the group's result
+   };
+   const_iterator begin() const;
+   const_iterator end() const;
+
+private:
+   // observer for one source, passes its events on with the side it is
+   class Source : public ListObserver<T> {
+   public:
+      ListView* view;
+      int side;                             // 0 for list1, 1 for list2
+      List<T>* list;                        // NULL once the list is gone
+
+      void inserted(const T& item, int equalAhead)
+         { view->add(side, item, equalAhead); }
+      void removed(const T& item) { view->drop(side, item); }
+      void cleared() { view->clear(side); }
+      void detached() { view->clear(side); list = NULL; }
+   };
+
+   Operation operation;
+   Source sources[2];
+   Groups groups;                           // ordered like the lists
+   int total;                               // size of the result
+
+   int contribution(const Group&) const;    // items the group puts in
+   int fromFirst(const Group&) const;       // how many are list1's
+   const T* at(typename Groups::const_iterator, int) const;
+   void add(int side, const T&, int);
+   void drop(int side, const T&);
+   void clear(int side);
+
+   ListView(const ListView&);               // not copyable
+   ListView& operator=(const ListView&);
+};
+
+//----------------------------------------------------------------------------
+// Constructor
+// files the items already in both lists and follows them from then on
+template <typename T>
+ListView<T>::ListView(List<T>& list1, List<T>& list2, Operation op)
+   : operation(op), total(0)
+{
+    List<T>* lists[2] = { &list1, &list2 };
+    for (int side = 0; side < 2; side++)
+    {
+        sources[side].view = this;
+        sources[side].side = side;
+        sources[side].list = lists[side];
+        //in list order, so each equal item goes behind the ones before it
+        for (typename List<T>::const_iterator it = lists[side]->begin();
+             it != lists[side]->end(); ++it)
+            add(side, *it, (int)lists[side]->size());
+    }
+    list1.addObserver(&sources[0]);
+    list2.addObserver(&sources[1]);
+}
+
+//----------------------------------------------------------------------------
+// Destructor
+template <typename T>
+ListView<T>::~ListView()
+{
+    for (int side = 0; side < 2; side++)
+    {
+        if (sources[side].list != NULL)
+            sources[side].list->removeObserver(&sources[side]);
+    }
+}
+
+//----------------------------------------------------------------------------
+// size
+template <typename T>
+int ListView<T>::size() const
+{
+    return total;
+}
+
+//----------------------------------------------------------------------------
+// contains
+template <typename T>
+bool ListView<T>::contains(const T& target) const
+{
+    return count(target) > 0;
+}
+
+//----------------------------------------------------------------------------
+// count
+template <typename T>
+int ListView<T>::count(const T& target) const
+{
+    Group probe;
+    probe.key = &target;
+    typename Groups::const_iterator it = groups.find(probe);
+    return it == groups.end() ? 0 : contribution(*it);
+}
+
+//----------------------------------------------------------------------------
+// exportTo
+// copies of the result, in order, as one sorted run
+template <typename T>
+void ListView<T>::exportTo(List<T>& list) const
+{
+    vector<T*> run;
+    run.reserve(total);
+    for (const_iterator it = begin(); it != end(); ++it)
+        run.push_back(new T(*it));
+    list.appendRun(run);
+}
+
+//----------------------------------------------------------------------------
+// begin
+template <typename T>
+typename ListView<T>::const_iterator ListView<T>::begin() const
+{
+    const_iterator it;
+    it.view = this;
+    it.group = groups.begin();
+    while (it.group != groups.end() && contribution(*it.group) == 0)
+        ++it.group;
+    return it;
+}
+
+//----------------------------------------------------------------------------
+// end
+template <typename T>
+typename ListView<T>::const_iterator ListView<T>::end() const
+{
+    const_iterator it;
+    it.view = this;
+    it.group = groups.end();
+    return it;
+}
+
+//----------------------------------------------------------------------------
+// operator++
+// on to the next item of the group, or the first group that puts any in
+// (an intersection group with items from one side only puts none)
+template <typename T>
+typename ListView<T>::const_iterator&
+ListView<T>::const_iterator::operator++()
+{
+    if (++index < view->contribution(*group))
+        return *this;
+    index = 0;
+    do
+        ++group;
+    while (group != view->groups.end() && view->contribution(*group) == 0);
+    return *this;
+}
+
+//----------------------------------------------------------------------------
+// at
+// item index of a group's part of the result: list1's items first, then
+// for a merge list2's
+template <typename T>
+const T* ListView<T>::at(typename Groups::const_iterator group,
+                         int index) const
+{
+    int first = fromFirst(*group);
+    return index < first ? group->items[0][index]
+                         : group->items[1][index - first];
+}
+
+//----------------------------------------------------------------------------
+// contribution
+template <typename T>
+int ListView<T>::contribution(const Group& group) const
+{
+    int a = group.items[0].size();
+    int b = group.items[1].size();
+    if (operation == MERGE)
+        return a + b;
+    return a < b ? a : b;
+}
+
+//----------------------------------------------------------------------------
+// fromFirst
+template <typename T>
+int ListView<T>::fromFirst(const Group& group) const
+{
+    return operation == MERGE ? (int)group.items[0].size()
+                              : contribution(group);
+}
+
+//----------------------------------------------------------------------------
+// add
+// an item entered source side: into its group, new or existing, behind
+// equalAhead of the group's items from that side (all of them when there
+// are fewer)
+template <typename T>
+void ListView<T>::add(int side, const T& item, int equalAhead)
+{
+    Group probe;
+    probe.key = &item;
+    typename Groups::iterator it = groups.insert(probe).first;
+    vector<const T*>& items = it->items[side];
+    size_t rank = equalAhead;
+    if (rank > items.size())
+        rank = items.size();
+    int before = contribution(*it);
+    items.insert(items.begin() + rank, &item);
+    total += contribution(*it) - before;
+}
+
+//----------------------------------------------------------------------------
+// drop
+// an item is about to leave source side. Only that very item goes, and the
+// group goes once it has no items left.
+template <typename T>
+void ListView<T>::drop(int side, const T& item)
+{
+    Group probe;
+    probe.key = &item;
+    typename Groups::iterator it = groups.find(probe);
+    if (it == groups.end())
+        return;
+
+    vector<const T*>& items = it->items[side];
+    typename vector<const T*>::iterator found =
+        find(items.begin(), items.end(), &item);
+    if (found == items.end())
+        return;
+
+    int before = contribution(*it);
+    items.erase(found);
+    total += contribution(*it) - before;
+
+    if (it->items[0].empty() && it->items[1].empty())
+        groups.erase(it);
+    else if (it->key == &item)
+        it->key = (it->items[0].empty() ? it->items[1] : it->items[0])[0];
+}
+
+//----------------------------------------------------------------------------
+// clear
+// every item of source side is about to go at once
+template <typename T>
+void ListView<T>::clear(int side)
+{
+    typename Groups::iterator it = groups.begin();
+    while (it != groups.end())
+    {
+        int before = contribution(*it);
+        it->items[side].clear();
+        total += contribution(*it) - before;
+
+        const vector<const T*>& other = it->items[1 - side];
+        if (other.empty())
+            groups.erase(it++);
+        else
+        {
+            it->key = other[0];
+            ++it;
+        }
+    }
+}
+
+#endif
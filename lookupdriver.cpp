@@ -0,0 +1,104 @@
+/////////////////////////////  lookupdriver.cpp  /////////////////////////////
+// Exercises List::retrieveMany and List::containsMany: on random lists with
+// repeated names, checks every answer against retrieve run once per probe
+// (the very same item, the first of equal ones), with probes sorted and
+// unsorted, repeated and missing. Also times a batch against the probes
+// retrieved one by one.
+//
+//    g++ -std=c++11 -O2 -pthread lookupdriver.cpp employee.cpp nodedata.cpp
+//    ./a.out [rounds] [employees] [probes]
+//
+// Exits with 1 if an answer differs.
+//----------------------------------------------------------------------------
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+using namespace std;
+
+#include "list.h"
+#include "employee.h"
+#include "driverutil.h"
+
+const int NAMES = 8;                        // few, so names repeat
+
+//-------------------------------  makeProbes  -------------------------------
+// count probes drawn from twice the names in the list, so about half are
+// missing and many repeat; sorted when asked
+vector<Employee> makeProbes(int count, int names, bool sorted) {
+   vector<Employee> probes;
+   for (int i = 0; i < count; i++) {
+      Employee* e = randomEmployee(-1, 2 * names);
+      probes.push_back(*e);
+      delete e;
+   }
+   if (sorted)
+      stable_sort(probes.begin(), probes.end());
+   return probes;
+}
+
+//--------------------------------  agrees  ----------------------------------
+// retrieveMany and containsMany against one retrieve per probe
+bool agrees(const List<Employee>& list, const vector<Employee>& probes) {
+   vector<Employee*> found;
+   vector<bool> contained;
+   list.retrieveMany(probes, found);
+   list.containsMany(probes, contained);
+   if (found.size() != probes.size() || contained.size() != probes.size())
+      return false;
+   for (size_t i = 0; i < probes.size(); i++) {
+      Employee* one;
+      bool there = list.retrieve(probes[i], one);
+      if (found[i] != (there ? one : NULL) || contained[i] != there)
+         return false;
+   }
+   return true;
+}
+
+int main(int argc, char* argv[]) {
+   int rounds = argc > 1 ? atoi(argv[1]) : 2000;
+   int employees = argc > 2 ? atoi(argv[2]) : 100000;
+   int batch = argc > 3 ? atoi(argv[3]) : 2000;
+   srand(31);
+
+   int failures = 0;
+   for (int round = 0; round < rounds; round++) {
+      List<Employee> company;
+      randomList(company, round == 0 ? 0 : rand() % 40, NAMES);
+      bool sorted = round % 3 == 0;
+      vector<Employee> probes = makeProbes(round == 1 ? 0 : rand() % 30,
+                                           NAMES, sorted);
+      if (!agrees(company, probes)) {
+         cout << (sorted ? "sorted" : "unsorted") << " probes differ in round "
+              << round << endl;
+         failures++;
+      }
+   }
+   cout << rounds << " random rounds, " << failures << " failed" << endl;
+
+   // timing: one batch of unsorted probes on a large list
+   int names = employees / 4 + 1;
+   List<Employee> company;
+   randomList(company, employees, names);
+   vector<Employee> probes = makeProbes(batch, names, false);
+   vector<Employee*> found;
+   TimePoint start = now();
+   company.retrieveMany(probes, found);
+   double manyTime = seconds(start);
+   int hits = 0;
+   start = now();
+   for (int i = 0; i < batch; i++) {
+      Employee* one;
+      if (company.retrieve(probes[i], one))
+         hits++;
+   }
+   double oneTime = seconds(start);
+   failures += !agrees(company, probes);
+   cout << company.size() << " employees, " << batch << " probes, " << hits
+        << " found  retrieveMany " << manyTime << "s  retrieve each "
+        << oneTime << "s" << endl;
+
+   cout << failures << " failures" << endl;
+   return failures == 0 ? 0 : 1;
+}
@@ -20,6 +20,22 @@ bool NodeData::setData(ifstream& infile) {
    return true;
 }
 
+//----------------------------  compare  -------------------------------------
+// negative, zero or positive as this is before, equal to or after obj,
+// by num and then ch
+int NodeData::compare(const NodeData& obj) const {
+   if (num != obj.num) return num < obj.num ? -1 : 1;
+   return ch - obj.ch;
+}
+
+//----------------------------  compare  -------------------------------------
+// same order against a (num, ch) key, so a List<NodeData> can be searched
+// without a NodeData
+int NodeData::compare(const pair<int, char>& key) const {
+   if (num != key.first) return num < key.first ? -1 : 1;
+   return ch - key.second;
+}
+
 //-------------------------------  <  ----------------------------------------
 // < defined by value of num; if nums equal, ch is used
 bool NodeData::operator<(const NodeData& obj) const {
@@ -48,6 +64,12 @@ bool NodeData::operator!=(const NodeData& obj) const {
    return !(*this == obj);
 }
 
+//----------------------------  hashValue  -----------------------------------
+// hash of num and ch, the same fields operator== compares
+unsigned long hashValue(const NodeData& obj) {
+   return (unsigned long)obj.num * 256 + (unsigned char)obj.ch;
+}
+
 //-------------------------------  <<  ---------------------------------------
 // display NodeData object
 ostream& operator<<(ostream& output, const NodeData& obj) {
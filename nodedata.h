@@ -6,11 +6,13 @@
 
 #include <iostream>
 #include <fstream>
+#include <utility>
 using namespace std;
 
 //---------------------------  class NodeData  ------------------------------
 class NodeData {                                 // incomplete class
    friend ostream& operator<<(ostream &, const NodeData &);
+   friend unsigned long hashValue(const NodeData &);  // for List fingerprint
 
 public:
    NodeData(int n = 0, char c = 'z');       // default constructor
@@ -18,6 +20,9 @@ public:
    bool setData(ifstream&);                 // reads data from file
 
    // <, > are defined by order of num; if nums are equal, ch is compared
+   int compare(const NodeData& N) const;    // <0, 0, >0 in that order
+   int compare(const pair<int, char>& key) const;  // same, against a plain
+                                            // (num, ch) key for List lookups
    bool operator<(const NodeData& N) const;
    bool operator>(const NodeData& N) const;
    bool operator==(const NodeData& N) const;
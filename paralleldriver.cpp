@@ -0,0 +1,66 @@
+////////////////////////////  paralleldriver.cpp  ////////////////////////////
+// Times List::parallelMerge and parallelIntersect against merge and
+// intersect on the same lists, and checks that each pair gives the same
+// list, item for item.
+//
+//    g++ -std=c++11 -O2 -pthread paralleldriver.cpp employee.cpp nodedata.cpp
+//    ./a.out [employees per list] [threads]
+//
+// threads defaults to the number of cores but at least 2, since with one
+// thread the parallel calls fall straight back to the serial code and the
+// check would never reach the partitioning. Lists shorter than List's
+// PARALLEL_MIN take the serial path anyway.
+// Exits with 1 if a result differs.
+//----------------------------------------------------------------------------
+
+#include <iostream>
+#include <algorithm>
+#include <thread>
+#include <cstdlib>
+using namespace std;
+
+#include "list.h"
+#include "employee.h"
+#include "driverutil.h"
+
+int main(int argc, char* argv[]) {
+   int employees = argc > 1 ? atoi(argv[1]) : 200000;
+   int threads = argc > 2 ? atoi(argv[2])
+                          : max(2, (int)thread::hardware_concurrency());
+   employees = max(employees, 1);
+   srand(5);
+
+   List<Employee> list1, list2;
+   randomList(list1, employees, employees);
+   randomList(list2, employees, employees);
+   cout << "two lists of " << employees << " employees, " << threads
+        << " threads" << endl;
+   int failures = 0;
+
+   // merge empties its params, so each run gets copies
+   List<Employee> a(list1), b(list2), c(list1), d(list2), serial, parallel;
+   TimePoint start = now();
+   serial.merge(a, b);
+   double serialTime = seconds(start);
+   start = now();
+   parallel.parallelMerge(c, d, threads);
+   double parallelTime = seconds(start);
+   bool same = text(serial) == text(parallel);
+   failures += !same;
+   cout << "merge      serial " << serialTime << "s  parallel "
+        << parallelTime << "s  " << (same ? "same" : "DIFFERENT") << endl;
+
+   List<Employee> serialBoth, parallelBoth;
+   start = now();
+   serialBoth.intersect(list1, list2);
+   serialTime = seconds(start);
+   start = now();
+   parallelBoth.parallelIntersect(list1, list2, threads);
+   parallelTime = seconds(start);
+   same = text(serialBoth) == text(parallelBoth);
+   failures += !same;
+   cout << "intersect  serial " << serialTime << "s  parallel "
+        << parallelTime << "s  " << (same ? "same" : "DIFFERENT") << endl;
+
+   return failures == 0 ? 0 : 1;
+}
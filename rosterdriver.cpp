@@ -0,0 +1,109 @@
+/////////////////////////////  rosterdriver.cpp  /////////////////////////////
+// Exercises CompressedRoster: builds one from a List<Employee> with long
+// shared name prefixes, checks that it prints and exports exactly like the
+// list and that retrieve finds the same employee as List::retrieve, and
+// compares its size and lookup time with the list's.
+//
+//    g++ -std=c++11 -O2 -pthread rosterdriver.cpp compressedroster.cpp
+//        employee.cpp nodedata.cpp
+//    ./a.out [employees] [lookups]
+//
+// Exits with 1 if a check fails.
+//----------------------------------------------------------------------------
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+using namespace std;
+
+#include "list.h"
+#include "employee.h"
+#include "compressedroster.h"
+#include "driverutil.h"
+
+//-------------------------------  randomNames  ------------------------------
+// department style last names, so neighbours share long prefixes, and few
+// first names, so some names repeat
+void randomNames(int which, string& last, string& first) {
+   ostringstream lastName, firstName;
+   lastName << "Engineering" << which % 7 << "Team" << which % 300;
+   firstName << "Member" << which % 40;
+   last = lastName.str();
+   first = firstName.str();
+}
+
+int main(int argc, char* argv[]) {
+   int employees = argc > 1 ? atoi(argv[1]) : 50000;
+   int lookups = argc > 2 ? atoi(argv[2]) : 2000;
+   srand(17);
+
+   vector<Employee*> all;
+   string last, first;
+   for (int i = 0; i < employees; i++) {
+      randomNames(rand(), last, first);
+      all.push_back(new Employee(last, first, rand() % 10000,
+                                 rand() % 100000));
+   }
+   stable_sort(all.begin(), all.end(), lessByName);
+   List<Employee> company;
+   company.appendRun(all);
+
+   CompressedRoster roster(company);
+   int failures = 0;
+   bool printsSame = text(roster) == text(company);
+   List<Employee> exported;
+   roster.exportTo(exported);
+   bool exportsSame = text(exported) == text(company);
+   failures += !printsSame + !exportsSame;
+   cout << roster.size() << " employees" << endl;
+   cout << "prints like the list: " << (printsSame ? "yes" : "no")
+        << ", exports like the list: " << (exportsSame ? "yes" : "no")
+        << endl;
+
+   // a node holds the Employee (two strings and two ints) and a pointer
+   size_t listBytes = company.size() * (sizeof(Employee) + sizeof(void*));
+   cout << "roster " << roster.bytesUsed() << " bytes, list nodes at least "
+        << listBytes << " bytes" << endl;
+
+   // lookups of names that are and are not there
+   vector<string> lasts(lookups), firsts(lookups);
+   for (int q = 0; q < lookups; q++) {
+      randomNames(rand(), lasts[q], firsts[q]);
+      if (q % 4 == 0)
+         firsts[q] += "x";                  // never there
+   }
+   vector<Employee> fromRoster(lookups), fromList(lookups);
+   vector<bool> foundRoster(lookups), foundList(lookups);
+
+   TimePoint start = now();
+   for (int q = 0; q < lookups; q++)
+      foundRoster[q] = roster.retrieve(EmployeeName(lasts[q], firsts[q]),
+                                       fromRoster[q]);
+   double rosterTime = seconds(start);
+   start = now();
+   for (int q = 0; q < lookups; q++) {
+      Employee* found;
+      foundList[q] = company.retrieve(EmployeeName(lasts[q], firsts[q]),
+                                      found);
+      if (foundList[q])
+         fromList[q] = *found;
+   }
+   double listTime = seconds(start);
+
+   int hits = 0;
+   for (int q = 0; q < lookups; q++) {
+      hits += foundList[q];
+      if (foundRoster[q] != foundList[q] || (foundList[q] &&
+          (fromRoster[q].getIdNumber() != fromList[q].getIdNumber() ||
+           fromRoster[q].getSalary() != fromList[q].getSalary())))
+         failures++;
+   }
+   cout << lookups << " lookups, " << hits << " found: roster " << rosterTime
+        << "s, list " << listTime << "s" << endl;
+
+   cout << failures << " failures" << endl;
+   return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,113 @@
+/////////////////////////////  setopsdriver.cpp  /////////////////////////////
+// Exercises the destructive set operations of List (setIntersect, setUnion,
+// setDifference, setSymmetricDifference): prints them for data31.txt and
+// data33.txt, then checks them on random lists against the std::set_*
+// algorithms run on copies of the names.
+//
+//    g++ -std=c++11 -O2 -pthread setopsdriver.cpp employee.cpp nodedata.cpp
+//    ./a.out [rounds]
+//
+// Exits with 1 if any result differs.
+//----------------------------------------------------------------------------
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <cstdlib>
+using namespace std;
+
+#include "list.h"
+#include "employee.h"
+#include "driverutil.h"
+
+enum Operation { INTERSECT, UNION, DIFFERENCE, SYMMETRIC };
+const char* const names[] = { "setIntersect", "setUnion", "setDifference",
+                              "setSymmetricDifference" };
+
+//------------------------------  runOperation  ------------------------------
+void runOperation(Operation op, List<Employee>& result, List<Employee>& list1,
+                  List<Employee>& list2) {
+   switch (op) {
+      case INTERSECT:  result.setIntersect(list1, list2);  break;
+      case UNION:      result.setUnion(list1, list2);  break;
+      case DIFFERENCE: result.setDifference(list1, list2);  break;
+      case SYMMETRIC:  result.setSymmetricDifference(list1, list2);  break;
+   }
+}
+
+//--------------------------------  keysOf  ----------------------------------
+// the distinct names of a list, "last first", in list order
+vector<string> keysOf(const List<Employee>& list) {
+   vector<string> keys;
+   for (List<Employee>::const_iterator it = list.begin(); it != list.end();
+        ++it)
+      keys.push_back(it->getLastName() + " " + it->getFirstName());
+   keys.erase(unique(keys.begin(), keys.end()), keys.end());
+   return keys;
+}
+
+//------------------------------  expectedKeys  ------------------------------
+// what the operation should leave, from the std algorithms
+vector<string> expectedKeys(Operation op, const vector<string>& a,
+                            const vector<string>& b) {
+   vector<string> out;
+   back_insert_iterator<vector<string> > to(out);
+   switch (op) {
+      case INTERSECT:
+         set_intersection(a.begin(), a.end(), b.begin(), b.end(), to);  break;
+      case UNION:
+         set_union(a.begin(), a.end(), b.begin(), b.end(), to);  break;
+      case DIFFERENCE:
+         set_difference(a.begin(), a.end(), b.begin(), b.end(), to);  break;
+      case SYMMETRIC:
+         set_symmetric_difference(a.begin(), a.end(), b.begin(), b.end(),
+                                  to);  break;
+   }
+   return out;
+}
+
+int main(int argc, char* argv[]) {
+   int rounds = argc > 1 ? atoi(argv[1]) : 1000;
+
+   for (int op = INTERSECT; op <= SYMMETRIC; op++) {
+      List<Employee> company1, company2, result;
+      ifstream infile1("data31.txt"), infile2("data33.txt");
+      company1.buildList(infile1);
+      company2.buildList(infile2);
+      runOperation((Operation)op, result, company1, company2);
+      cout << names[op] << " of data31 and data33:" << endl << result
+           << "both lists now empty: "
+           << (company1.isEmpty() && company2.isEmpty() ? "yes" : "no")
+           << endl << endl;
+   }
+
+   srand(7);
+   int failures = 0;
+   for (int round = 0; round < rounds; round++) {
+      Operation op = (Operation)(round % 4);
+      List<Employee> list1, list2, result;
+      randomList(list1, rand() % 30, 40);
+      randomList(list2, rand() % 30, 40);
+      vector<string> expected = expectedKeys(op, keysOf(list1),
+                                             keysOf(list2));
+
+      // every other round the result is one of the params
+      List<Employee>* into = &result;
+      if (round % 2 == 1)
+         into = round % 4 == 1 ? &list1 : &list2;
+      runOperation(op, *into, list1, list2);
+
+      vector<string> actual = keysOf(*into);
+      bool emptied = (into == &list1 || list1.isEmpty()) &&
+                     (into == &list2 || list2.isEmpty());
+      if (actual != expected || (int)actual.size() != into->size() ||
+          !emptied) {
+         cout << names[op] << " differs in round " << round << endl;
+         failures++;
+      }
+   }
+   cout << rounds << " random rounds, " << failures << " failed" << endl;
+   return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,98 @@
+/////////////////////////////  splicedriver.cpp  /////////////////////////////
+// Exercises moving nodes between Lists without copying: extract and insert
+// of a NodeHandle, remove handing the item to the caller, and splice of a
+// key range. Shows them on data31.txt and data33.txt, then checks splice
+// on random lists against copying the range item by item.
+//
+//    g++ -std=c++11 -O2 -pthread splicedriver.cpp employee.cpp nodedata.cpp
+//    ./a.out [rounds]
+//
+// Exits with 1 if a check fails.
+//----------------------------------------------------------------------------
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+using namespace std;
+
+#include "list.h"
+#include "employee.h"
+#include "driverutil.h"
+
+//----------------------------  spliceByCopying  -----------------------------
+// what splice should leave, built from copies: in to, the items of to with
+// the range of from merged in behind equal ones; in kept, the rest of from
+void spliceByCopying(const List<Employee>& from, const List<Employee>& to,
+                     List<Employee>& result, List<Employee>& kept,
+                     const Employee& lo, const Employee& hi) {
+   vector<Employee*> moved, stayed, already, merged;
+   for (List<Employee>::const_iterator it = from.begin(); it != from.end();
+        ++it) {
+      bool inRange = listCompare(*it, lo) >= 0 && listCompare(*it, hi) <= 0;
+      (inRange ? moved : stayed).push_back(new Employee(*it));
+   }
+   for (List<Employee>::const_iterator it = to.begin(); it != to.end(); ++it)
+      already.push_back(new Employee(*it));
+   merge(already.begin(), already.end(), moved.begin(), moved.end(),
+         back_inserter(merged), lessByName);
+   result.appendRun(merged);
+   kept.appendRun(stayed);
+}
+
+int main(int argc, char* argv[]) {
+   int rounds = argc > 1 ? atoi(argv[1]) : 1000;
+   List<Employee> company1, company2;
+   ifstream infile1("data31.txt"), infile2("data33.txt");
+   company1.buildList(infile1);
+   company2.buildList(infile2);
+   cout << "company1:" << endl << company1 << endl;
+   cout << "company2:" << endl << company2 << endl;
+
+   // one node from company1 to company2, never copied
+   List<Employee>::NodeHandle handle =
+      company1.extract(Employee("Mouse", "Mickey"));
+   if (handle.empty())
+      cout << "extracted: nothing" << endl;
+   else
+      cout << "extracted: " << handle.value();
+   company2.insert(std::move(handle));
+   cout << "company2 after insert:" << endl << company2 << endl;
+
+   // remove hands the item over, the caller deletes it
+   Employee* removed;
+   if (company2.remove(Employee("Clark", "Jackson"), removed)) {
+      cout << "removed: " << *removed;
+      delete removed;
+   }
+
+   // everything from H through J moves over in one piece
+   company1.splice(company2, Employee("H", ""), Employee("Jz", ""));
+   cout << "company1 after splice of H..J from company2:" << endl
+        << company1 << "company2:" << endl << company2 << endl;
+
+   srand(9);
+   int failures = 0;
+   for (int round = 0; round < rounds; round++) {
+      List<Employee> from, to;
+      randomList(from, rand() % 40, 20);
+      randomList(to, rand() % 40, 20);
+      ostringstream lo, hi;
+      lo << "Last" << rand() % 20;
+      hi << "Last" << rand() % 20;
+      Employee low(lo.str(), "F"), high(hi.str(), "F");
+
+      List<Employee> wantTo, wantFrom;
+      spliceByCopying(from, to, wantTo, wantFrom, low, high);
+      to.splice(from, low, high);
+      if (text(to) != text(wantTo) || text(from) != text(wantFrom) ||
+          to.size() != wantTo.size() || from.size() != wantFrom.size()) {
+         cout << "splice differs in round " << round << endl;
+         failures++;
+      }
+   }
+   cout << rounds << " random splices, " << failures << " failed" << endl;
+   return failures == 0 ? 0 : 1;
+}
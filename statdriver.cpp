@@ -0,0 +1,182 @@
+//////////////////////////////  statdriver.cpp  //////////////////////////////
+// Times OrderStatisticIndex rank, select and percentile against walking the
+// List for the same answer, and checks that the two agree. Percentiles are
+// asked in tenths of a percent, so the walk can find the rank in integers.
+//
+//    g++ -std=c++11 -O2 -pthread statdriver.cpp employee.cpp nodedata.cpp
+//    ./a.out [employees] [queries]
+//
+// Exits with 1 if any answer differs.
+//----------------------------------------------------------------------------
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+using namespace std;
+
+#include "list.h"
+#include "listindex.h"
+#include "employee.h"
+#include "driverutil.h"
+
+const int NAMES = 2500;                     // distinct names, so they repeat
+
+//--------------------------------  walkRank  --------------------------------
+// employees that sort before key, by walking the list
+int walkRank(const List<Employee>& list, const Employee& key) {
+   int less = 0;
+   for (List<Employee>::const_iterator it = list.begin();
+        it != list.end() && listCompare(*it, key) < 0; ++it)
+      less++;
+   return less;
+}
+
+//-------------------------------  walkSelect  -------------------------------
+// the k-th employee by name, by walking the list
+const Employee* walkSelect(const List<Employee>& list, int k) {
+   List<Employee>::const_iterator it = list.begin();
+   for (int i = 0; i < k && it != list.end(); i++)
+      ++it;
+   return it == list.end() ? NULL : &*it;
+}
+
+//------------------------------  bySalaryWalk  ------------------------------
+// the employees by salary, equal salaries in list order, from a walk of the
+// list and a stable sort
+bool lessBySalary(const Employee* a, const Employee* b) {
+   return a->getSalary() < b->getSalary();
+}
+
+vector<const Employee*> bySalaryWalk(const List<Employee>& list) {
+   vector<const Employee*> order;
+   for (List<Employee>::const_iterator it = list.begin(); it != list.end();
+        ++it)
+      order.push_back(&*it);
+   stable_sort(order.begin(), order.end(), lessBySalary);
+   return order;
+}
+
+//-----------------------------  walkPercentile  -----------------------------
+// nearest rank salary percentile for tenths / 10 percent, by walking the
+// list and selecting from a copy of the salaries. The rank is the smallest
+// k with 1000 k >= tenths n, worked out in integers.
+int walkPercentile(const List<Employee>& list, int tenths) {
+   vector<int> salaries;
+   for (List<Employee>::const_iterator it = list.begin(); it != list.end();
+        ++it)
+      salaries.push_back(it->getSalary());
+   long long n = salaries.size();
+   int k = (int)((tenths * n + 999) / 1000);
+   k = max(1, min(k, (int)n));
+   nth_element(salaries.begin(), salaries.begin() + k - 1, salaries.end());
+   return salaries[k - 1];
+}
+
+//---------------------------  checkExactPercentiles  ------------------------
+// 100 salaries 100, 200, ..., 10000: p percent is exactly salary 100 p, the
+// cases p / 100 * n rounds past (7 and 14 among them) included
+int checkExactPercentiles() {
+   List<Employee> hundred;
+   OrderStatisticIndex<Employee, int, EmployeeSalary> bySalary(hundred);
+   for (int i = 1; i <= 100; i++)
+      hundred.insert(new Employee("Last", "F", i, 100 * i));
+
+   int mismatches = 0;
+   for (int p = 1; p <= 100; p++) {
+      int indexed = bySalary.percentile(p)->getSalary();
+      int walked = walkPercentile(hundred, 10 * p);
+      if (indexed != 100 * p || walked != 100 * p) {
+         cout << "percentile " << p << " of 100: index " << indexed
+              << ", walk " << walked << ", expected " << 100 * p << endl;
+         mismatches++;
+      }
+   }
+   return mismatches;
+}
+
+int main(int argc, char* argv[]) {
+   int employees = argc > 1 ? atoi(argv[1]) : 20000;
+   int queries = argc > 2 ? atoi(argv[2]) : 500;
+   employees = max(employees, 1);
+   srand(3);
+
+   List<Employee> company;
+   OrderStatisticIndex<Employee> byName(company);
+   OrderStatisticIndex<Employee, int, EmployeeSalary> bySalary(company);
+   for (int i = 0; i < employees; i++)
+      company.insert(randomEmployee(i, NAMES));
+
+   // some churn, so the indexes follow removes as well as inserts
+   for (int i = 0; i < employees / 10; i++) {
+      Employee* key = randomEmployee(0, NAMES);
+      Employee* gone;
+      if (company.remove(*key, gone))
+         delete gone;
+      delete key;
+      company.insert(randomEmployee(employees + i, NAMES));
+   }
+   cout << company.size() << " employees, " << queries << " queries each"
+        << endl;
+
+   vector<Employee*> keys;
+   vector<int> ks;
+   vector<int> tenths;
+   for (int q = 0; q < queries; q++) {
+      keys.push_back(randomEmployee(0, NAMES));
+      ks.push_back(rand() % company.size());
+      tenths.push_back(rand() % 1000 + 1);
+   }
+
+   int mismatches = checkExactPercentiles();
+   vector<int> walked(queries), indexed(queries);
+   vector<const Employee*> walkedItems(queries), indexedItems(queries);
+
+   // rank
+   TimePoint start = now();
+   for (int q = 0; q < queries; q++)
+      walked[q] = walkRank(company, *keys[q]);
+   double walkTime = seconds(start);
+   start = now();
+   for (int q = 0; q < queries; q++)
+      indexed[q] = byName.rank(*keys[q]);
+   double indexTime = seconds(start);
+   mismatches += walked != indexed;
+   cout << "rank        walk " << walkTime << "s  index " << indexTime << "s"
+        << endl;
+
+   // select; equal keys are in list order, so the very same item comes back
+   start = now();
+   for (int q = 0; q < queries; q++)
+      walkedItems[q] = walkSelect(company, ks[q]);
+   walkTime = seconds(start);
+   start = now();
+   for (int q = 0; q < queries; q++)
+      indexedItems[q] = byName.select(ks[q]);
+   indexTime = seconds(start);
+   vector<const Employee*> salaryOrder = bySalaryWalk(company);
+   for (int q = 0; q < queries; q++)
+      mismatches += walkedItems[q] == NULL ||
+                    walkedItems[q] != indexedItems[q] ||
+                    bySalary.select(ks[q]) != salaryOrder[ks[q]];
+   cout << "select      walk " << walkTime << "s  index " << indexTime << "s"
+        << endl;
+
+   // salary percentile
+   start = now();
+   for (int q = 0; q < queries; q++)
+      walked[q] = walkPercentile(company, tenths[q]);
+   walkTime = seconds(start);
+   start = now();
+   for (int q = 0; q < queries; q++)
+      indexed[q] = bySalary.percentile(tenths[q] / 10.0)->getSalary();
+   indexTime = seconds(start);
+   mismatches += walked != indexed;
+   cout << "percentile  walk " << walkTime << "s  index " << indexTime << "s"
+        << endl;
+
+   for (int q = 0; q < queries; q++)
+      delete keys[q];
+   cout << (mismatches == 0 ? "all answers agree" : "answers differ") << endl;
+   return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,100 @@
+//////////////////////////////  viewdriver.cpp  //////////////////////////////
+// Exercises ListView: keeps an intersect view and a merge view of two lists
+// of employees while the lists change, checks after every change that each
+// view prints exactly like List::intersect or List::merge run on copies of
+// the lists, and times walking the views against recomputing the results.
+//
+//    g++ -std=c++11 -O2 -pthread viewdriver.cpp employee.cpp nodedata.cpp
+//    ./a.out [employees] [changes]
+//
+// Exits with 1 if a view differs.
+//----------------------------------------------------------------------------
+
+#include <iostream>
+#include <algorithm>
+#include <cstdlib>
+using namespace std;
+
+#include "list.h"
+#include "listview.h"
+#include "employee.h"
+#include "driverutil.h"
+
+//--------------------------------  walk  ------------------------------------
+// items in a view, counted by walking it
+int walk(const ListView<Employee>& view) {
+   int items = 0;
+   for (ListView<Employee>::const_iterator it = view.begin();
+        it != view.end(); ++it)
+      items++;
+   return items;
+}
+
+int main(int argc, char* argv[]) {
+   int employees = argc > 1 ? atoi(argv[1]) : 2000;
+   int changes = argc > 2 ? atoi(argv[2]) : 300;
+   int names = max(employees / 4, 1);
+   srand(13);
+
+   List<Employee> company1, company2;
+   for (int i = 0; i < employees; i++) {
+      company1.insert(randomEmployee(i, names));
+      company2.insert(randomEmployee(employees + i, names));
+   }
+   ListView<Employee> both(company1, company2);
+   ListView<Employee> all(company1, company2, ListView<Employee>::MERGE);
+
+   int failures = 0;
+   double viewTime = 0;
+   double recomputeTime = 0;
+   for (int change = 0; change < changes; change++) {
+      List<Employee>& changed = rand() % 2 ? company1 : company2;
+      if (rand() % 3 == 0) {
+         Employee* key = randomEmployee(0, names);
+         Employee* gone;
+         if (changed.remove(*key, gone))
+            delete gone;
+         delete key;
+      }
+      else
+         changed.insert(randomEmployee(2 * employees + change, names));
+
+      TimePoint start = now();
+      int walked = walk(both) + walk(all);
+      viewTime += seconds(start);
+
+      // merge empties its params, so it runs on copies
+      start = now();
+      List<Employee> copy1(company1), copy2(company2), intersection, merged;
+      intersection.intersect(copy1, copy2);
+      merged.merge(copy1, copy2);
+      recomputeTime += seconds(start);
+
+      // List::merge keeps one copy of two lists with equal contents
+      bool sameLists = company1 == company2;
+      if (walked != both.size() + all.size() ||
+          text(both) != text(intersection) ||
+          both.size() != intersection.size() ||
+          (!sameLists && (text(all) != text(merged) ||
+                          all.size() != merged.size()))) {
+         cout << "a view differs after change " << change << endl;
+         failures++;
+      }
+   }
+   cout << changes << " changes to lists of about " << employees
+        << " employees" << endl;
+   cout << "intersect view " << both.size() << " items, merge view "
+        << all.size() << " items" << endl;
+   cout << "walking the views " << viewTime << "s, recomputing "
+        << recomputeTime << "s" << endl;
+
+   // makeEmpty of one source leaves nothing to intersect
+   company2.makeEmpty();
+   bool emptied = both.size() == 0 && all.size() == company1.size();
+   failures += !emptied;
+   cout << "after makeEmpty of company2: intersect view " << both.size()
+        << " items, merge view " << all.size() << " items" << endl;
+
+   cout << failures << " failures" << endl;
+   return failures == 0 ? 0 : 1;
+}